@@ -1,5 +1,6 @@
 #include "thalesremoteconnection.h"
 #include "thalesremotescriptwrapper.h"
+#include "fracalibration.h"
 
 int main(int argc, char *argv[]) {
 
@@ -35,12 +36,22 @@ int main(int argc, char *argv[]) {
      * Now the device which is analog controlled by FRA should be switched on with its own interface.
      * Then you can measure EIS via FRA like with the internal potentiostat.
      */
-    for (double i = 1; i < 8 ; i += 1) {
-        zahnerZennium.setCurrent(i);
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        std::cout << zahnerZennium.getPotential() << std::endl;
-        std::cout << zahnerZennium.getCurrent() << std::endl;
+    FraCalibration calibration(&zahnerZennium);
+    FraCalibration::Settings settings;
+    settings.mode = PotentiostatMode::GALVANOSTATIC;
+    settings.minimum = 1;
+    settings.maximum = 7;
+    settings.steps = 7;
+    settings.inputGain = -220.0/5.0;
+    settings.outputGain = -220.0/5.0;
+
+    auto result = calibration.run(settings);
+    for (const auto& step : result.steps) {
+        std::cout << step.setValue << " " << step.measuredValue << " " << step.settleTime.count() << std::endl;
     }
+    std::cout << "output gain: " << result.outputGain << " offset: " << result.outputOffset << std::endl;
+
+    calibration.apply(result);
 
     zahnerZennium.setEISNaming(NamingRule::COUNTER);
     zahnerZennium.setEISCounter(1);
@@ -0,0 +1,106 @@
+#include "ism_txt_parser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+/*
+ * Compares the single pass parser of the gRPC server with the previous stream based parser.
+ *
+ * Usage: IsmTxtParserBenchmark [export.txt]
+ * Without argument a text export with 2000000 rows and CRLF line endings is generated in the temporary directory.
+ */
+
+static std::string generateExport(size_t rows) {
+    const std::string filename = (fs::temp_directory_path() / "ism_txt_parser_benchmark.txt").string();
+    std::ofstream file(filename, std::ios::binary);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> frequency(0.01, 1e6);
+    std::uniform_real_distribution<double> impedance(0.0, 1e3);
+    std::uniform_real_distribution<double> phase(-90.0, 90.0);
+
+    file << "Spectrum export\r\nNumber   Frequency/Hz   Impedance/Ohm   Phase/deg\r\n";
+    char line[128];
+    for (size_t i = 0; i < rows; i++) {
+        const int length = std::snprintf(line, sizeof(line), "%6zu  %.6e  %.6e  %+.4f\r\n", i, frequency(generator), impedance(generator), phase(generator));
+        file.write(line, length);
+    }
+    return filename;
+}
+
+// Previous stream based parser of the gRPC server, kept as reference.
+// The data lines are read from the converted content, the original read them from the file stream at EOF.
+static DataColumns parseFileWithStreams(const std::string& filename) {
+    DataColumns data;
+    std::ifstream file(filename);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Replace CR with LF to make std::getline work as expected
+    std::replace(content.begin(), content.end(), '\r', '\n');
+
+    std::stringstream ss(content);
+    std::string line;
+
+    // Find header line
+    while (std::getline(ss, line)) {
+        if (line.find("Number") != std::string::npos && line.find("Frequency/Hz") != std::string::npos) {
+            break; // Found header, exit loop
+        }
+    }
+
+    // Read actual data
+    while (std::getline(ss, line)) {
+        std::istringstream iss(line);
+        int number;
+        double frequency;
+        double impedance;
+        double phase;
+
+        if (iss >> number >> frequency >> impedance >> phase) {
+            data.number.push_back(number);
+            data.frequency.push_back(frequency);
+            data.impedance.push_back(impedance);
+            data.phase.push_back(phase);
+        }
+    }
+
+    return data;
+}
+
+template <typename Parser>
+static DataColumns measure(const std::string& name, const std::string& filename, Parser parser) {
+    DataColumns retval;
+    double best = 0.0;
+
+    for (int run = 0; run < 3; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        retval = parser(filename);
+        const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+        if (run == 0 || duration.count() < best) {
+            best = duration.count();
+        }
+    }
+
+    std::cout << name << ": " << retval.size() << " rows, best of 3 runs " << best << " ms" << std::endl;
+    return retval;
+}
+
+int main(int argc, char *argv[]) {
+
+    const std::string filename = argc > 1 ? std::string(argv[1]) : generateExport(2000000);
+    std::cout << "File: " << filename << " (" << fs::file_size(filename) << " bytes)" << std::endl;
+
+    const auto streams = measure("stream parser", filename, parseFileWithStreams);
+    const auto mapped = measure("single pass parser", filename, parseFile);
+
+    const bool equal = streams.number == mapped.number && streams.frequency == mapped.frequency &&
+                       streams.impedance == mapped.impedance && streams.phase == mapped.phase;
+    std::cout << "Results " << (equal ? "are identical" : "differ") << std::endl;
+
+    return equal ? 0 : 1;
+}
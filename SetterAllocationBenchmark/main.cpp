@@ -0,0 +1,175 @@
+#include "thalesremoteconnection.h"
+#include "thalesremotescriptwrapper.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+/*
+ * Counts the allocations of the library and those of the thread which calls the setters.
+ * The receiving thread of the connection allocates the incoming telegrams, so both numbers are reported.
+ * The built-in stand-in for Term does not count.
+ */
+static std::atomic<unsigned long long> processAllocations{0};
+static thread_local unsigned long long threadAllocations = 0;
+static thread_local bool countAllocations = true;
+
+void* operator new(std::size_t size) {
+    if (countAllocations == true) {
+        processAllocations++;
+        threadAllocations++;
+    }
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+static bool receiveAll(SOCKET socket, char* data, size_t size) {
+    while (size > 0) {
+        auto received = recv(socket, data, static_cast<int>(size), 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+static void sendTelegram(SOCKET socket, int channel, const std::string& payload) {
+    std::string telegram = {static_cast<char>(payload.size() & 0xff), static_cast<char>(payload.size() >> 8), static_cast<char>(channel)};
+    telegram += payload;
+    send(socket, telegram.data(), static_cast<int>(telegram.size()), 0);
+}
+
+/*
+ * Minimal stand-in for Term on port 260: accepts the registration, answers the version request and
+ * the deregistration on channel 128 and answers every Remote Script command with "OK".
+ */
+static void fakeTerm(SOCKET listener) {
+    countAllocations = false;
+    SOCKET connection = accept(listener, nullptr, nullptr);
+    if (connection == INVALID_SOCKET) {
+        return;
+    }
+
+    int noDelay = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+    char registration[8];
+    if (receiveAll(connection, registration, sizeof(registration)) == true) {
+        std::string name(((static_cast<unsigned char>(registration[0]) << 8) | static_cast<unsigned char>(registration[1])), '\0');
+        receiveAll(connection, name.data(), name.size());
+
+        char header[3];
+        std::string payload;
+        while (receiveAll(connection, header, sizeof(header)) == true) {
+            payload.resize(static_cast<unsigned char>(header[0]) | (static_cast<unsigned char>(header[1]) << 8));
+            if (receiveAll(connection, payload.data(), payload.size()) == false) {
+                break;
+            }
+
+            const int channel = static_cast<unsigned char>(header[2]);
+            if (channel == 2) {
+                sendTelegram(connection, 2, "OK");
+            } else if (channel == 128) {
+                sendTelegram(connection, 128, payload.find(",7") != std::string::npos ? "3,Term,6.0.0" : "OK");
+            }
+        }
+    }
+    closesocket(connection);
+}
+
+static void measure(const std::string& name, int calls, const std::function<void()>& setter) {
+    for (int i = 0; i < 100; i++) {
+        setter();
+    }
+
+    const auto processBefore = processAllocations.load();
+    const auto threadBefore = threadAllocations;
+    for (int i = 0; i < calls; i++) {
+        setter();
+    }
+    const double perCallThread = static_cast<double>(threadAllocations - threadBefore) / calls;
+    const double perCallProcess = static_cast<double>(processAllocations.load() - processBefore) / calls;
+
+    std::cout << name << ": " << perCallThread << " allocations per call in the calling thread, "
+              << perCallProcess << " including the receiving thread" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+    const int calls = 10000;
+    ZenniumConnection zenniumConnection;
+
+    /*
+     * Without argument the benchmark runs against the built-in stand-in on the local computer,
+     * otherwise against Term on the given host.
+     */
+    std::string host = "127.0.0.1";
+    std::thread server;
+    if (argc > 1) {
+        host = argv[1];
+    } else {
+        SOCKET listener = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(260);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 1) != 0) {
+            std::cout << "Port 260 is not available, pass the address of Term as argument." << std::endl;
+            return 1;
+        }
+        server = std::thread(fakeTerm, listener);
+    }
+
+    zenniumConnection.connectToTerm(host, "ScriptRemote");
+    ThalesRemoteScriptWrapper zahnerZennium(&zenniumConnection);
+
+    measure("setFrequency", calls, [&zahnerZennium]() { zahnerZennium.setFrequency(1000); });
+    measure("setPotential", calls, [&zahnerZennium]() { zahnerZennium.setPotential(0.5); });
+    measure("setAmplitude", calls, [&zahnerZennium]() { zahnerZennium.setAmplitude(10e-3); });
+    measure("setNumberOfPeriods", calls, [&zahnerZennium]() { zahnerZennium.setNumberOfPeriods(3); });
+
+    zenniumConnection.disconnectFromTerm();
+    if (server.joinable() == true) {
+        server.join();
+    }
+
+    return 0;
+}
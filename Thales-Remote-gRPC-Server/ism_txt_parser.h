@@ -1,53 +1,179 @@
 #pragma once
 
+#include <charconv>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <string_view>
 #include <vector>
 #include <filesystem>
+#include "ismfile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
-struct DataEntry {
-    int number;
-    double frequency;
-    double impedance;
-    double phase;
+// Columns of a spectrum text export, all vectors have the same length
+struct DataColumns {
+    std::vector<int> number;
+    std::vector<double> frequency;
+    std::vector<double> impedance;
+    std::vector<double> phase;
+
+    size_t size() const { return number.size(); }
 };
 
-std::vector<DataEntry> parseFile(const std::string& filename) {
-    std::vector<DataEntry> data;
-    std::ifstream file(filename);
-    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+// Read-only memory mapping of a whole file, empty if the file could not be mapped
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) {
+            return;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ != nullptr) {
+            size_ = static_cast<size_t>(size.QuadPart);
+        }
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(data);
+                size_ = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
 
-    // Replace CR with LF to make std::getline work as expected
-    std::replace(content.begin(), content.end(), '\r', '\n');
+    std::string_view view() const { return std::string_view(data_ != nullptr ? data_ : "", size_); }
 
-    std::stringstream ss(content);
-    std::string line;
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
 
-    // Find header line
-    while (std::getline(ss, line)) {
-        if (line.find("Number") != std::string::npos && line.find("Frequency/Hz") != std::string::npos) {
-            break; // Found header, exit loop
-        }
+inline const char* skipBlanks(const char* position, const char* end) {
+    while (position < end && (*position == ' ' || *position == '\t')) {
+        ++position;
+    }
+    return position;
+}
+
+template <typename T>
+inline const char* parseValue(const char* position, const char* end, T& value) {
+    position = skipBlanks(position, end);
+    if (position < end && *position == '+') {
+        ++position;
     }
+    auto result = std::from_chars(position, end, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Parse the data lines after the header of a text export in a single pass.
+// Lines may end with CR, LF or CRLF, lines which are not a complete data row are skipped.
+inline DataColumns parseContent(std::string_view content) {
+    DataColumns data;
+    const char* position = content.data();
+    const char* end = content.data() + content.size();
+    bool headerFound = false;
+
+    while (position < end) {
+        const char* lineEnd = position;
+        while (lineEnd < end && *lineEnd != '\r' && *lineEnd != '\n') {
+            ++lineEnd;
+        }
 
-    // Read actual data
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        DataEntry entry;
+        std::string_view line(position, lineEnd - position);
+        if (!headerFound) {
+            headerFound = line.find("Number") != std::string_view::npos && line.find("Frequency/Hz") != std::string_view::npos;
+        }
+        else if (!line.empty()) {
+            int number;
+            double frequency;
+            double impedance;
+            double phase;
+            const char* field = parseValue(position, lineEnd, number);
+            field = field ? parseValue(field, lineEnd, frequency) : nullptr;
+            field = field ? parseValue(field, lineEnd, impedance) : nullptr;
+            field = field ? parseValue(field, lineEnd, phase) : nullptr;
+            if (field) {
+                data.number.push_back(number);
+                data.frequency.push_back(frequency);
+                data.impedance.push_back(impedance);
+                data.phase.push_back(phase);
+            }
+        }
 
-        if (iss >> entry.number >> entry.frequency >> entry.impedance >> entry.phase) {
-            data.push_back(entry);
+        position = lineEnd;
+        if (position < end && *position == '\r') {
+            ++position;
+        }
+        if (position < end && *position == '\n') {
+            ++position;
         }
     }
 
     return data;
 }
 
+DataColumns parseFile(const std::string& filename) {
+    MappedFile file(filename);
+    return parseContent(file.view());
+}
 
-std::string writeToCSV(const std::string& directoryPath, const std::string& filename, const std::vector<DataEntry>& data) {
+std::string writeToCSV(const std::string& directoryPath, const std::string& filename, const DataColumns& data) {
     std::string csvFilename = directoryPath + "/" + filename + ".csv"; // Store CSV in directoryPath
     std::ofstream outFile(csvFilename);
 
@@ -57,8 +183,30 @@ std::string writeToCSV(const std::string& directoryPath, const std::string& file
 
     outFile << "Number,Frequency/Hz,Impedance/Ohm,Phase/deg\n";
 
-    for (const auto& entry : data) {
-        outFile << entry.number << "," << entry.frequency << "," << entry.impedance << "," << entry.phase << "\n";
+    for (size_t i = 0; i < data.size(); i++) {
+        outFile << data.number[i] << "," << data.frequency[i] << "," << data.impedance[i] << "," << data.phase[i] << "\n";
+    }
+
+    return csvFilename;
+}
+
+// The suffix .ism.csv keeps the CSV apart from the one of a text export with the same stem
+std::string writeToCSV(const std::string& directoryPath, const std::string& filename, const IsmFile& spectrum) {
+    std::string csvFilename = directoryPath + "/" + filename + ".ism.csv";
+    std::ofstream outFile(csvFilename);
+
+    if (!outFile) {
+        throw std::runtime_error("Failed to open file: " + csvFilename);
+    }
+
+    outFile << "Number,Frequency/Hz,Impedance/Ohm,Phase/deg,Time/s\n";
+
+    const auto& frequencies = spectrum.getFrequencies();
+    const auto& impedances = spectrum.getImpedances();
+    const auto& phases = spectrum.getPhases();
+    const auto& times = spectrum.getTimes();
+    for (size_t i = 0; i < spectrum.getNumberOfSamples(); i++) {
+        outFile << (i + 1) << "," << frequencies[i] << "," << impedances[i] << "," << phases[i] << "," << times[i] << "\n";
     }
 
     return csvFilename;
@@ -69,10 +217,19 @@ std::vector<std::string> processDirectory(const std::string& directoryPath) {
 
     for (const auto& entry : fs::directory_iterator(directoryPath)) {
         if (entry.is_regular_file() && entry.path().extension() == ".txt") {
-            std::vector<DataEntry> fileData = parseFile(entry.path().string());
+            DataColumns fileData = parseFile(entry.path().string());
             std::string csvFilename = writeToCSV(directoryPath,entry.path().stem().string(), fileData);
             csvFiles.push_back(csvFilename);
         }
+        else if (entry.is_regular_file() && entry.path().extension() == ".ism") {
+            try {
+                IsmFile spectrum = IsmFile::fromFile(entry.path());
+                csvFiles.push_back(writeToCSV(directoryPath, entry.path().stem().string(), spectrum));
+            }
+            catch (const std::exception& e) {
+                std::cout << "Exception in processDirectory " << entry.path().string() << ": " << e.what() << std::endl;
+            }
+        }
     }
 
     return csvFiles;
@@ -113,10 +113,19 @@ public:
 
 		for (const auto& entry : fs::directory_iterator(directoryPath)) {
 			if (entry.is_regular_file() && entry.path().extension() == ".txt") {
-				std::vector<DataEntry> fileData = parseFile(entry.path().string());
+				DataColumns fileData = parseFile(entry.path().string());
 				std::string csvFilename = writeToCSV(directoryPath, entry.path().stem().string(), fileData);
 				csvFiles.push_back(csvFilename);
 			}
+			else if (entry.is_regular_file() && entry.path().extension() == ".ism") {
+				try {
+					IsmFile spectrum = IsmFile::fromFile(entry.path());
+					csvFiles.push_back(writeToCSV(directoryPath, entry.path().stem().string(), spectrum));
+				}
+				catch (const std::exception& e) {
+					std::cout << "Exception in ParseFiles " << entry.path().string() << ": " << e.what() << std::endl;
+				}
+			}
 		}
 
 		for (const auto& filename : csvFiles) {
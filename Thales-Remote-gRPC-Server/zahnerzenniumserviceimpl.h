@@ -376,12 +376,11 @@ public:
 		}
 
 		try {
-			std::string reply = wrapper->getImpedancePad4(request->frequency());
-			std::string timestamp = getISOCurrentTimestamp();
-			std::vector<std::complex<double>> impedances = pad4StringToComplex(reply);
+			Pad4Impedance impedances = wrapper->measurePad4Impedance(request->frequency());
+			std::string timestamp = getISOTimestamp(wrapper->getLastCommandTimestamps());
 
 			auto* vector_response = response->mutable_impedances();
-			for (const auto& z : impedances) {
+			for (const auto& z : impedances.getImpedances()) {
 				ComplexNumber* cn = vector_response->add_values();
 				cn->set_real(z.real());
 				cn->set_imag(z.imag());
@@ -404,12 +403,11 @@ public:
 		}
 
 		try {
-			std::string reply = wrapper->getImpedancePad4(request->frequency(), request->amplitude(), request->num_periods());
-			std::string timestamp = getISOCurrentTimestamp();
-			std::vector<std::complex<double>> impedances = pad4StringToComplex(reply);
-			
+			Pad4Impedance impedances = wrapper->measurePad4Impedance(request->frequency(), request->amplitude(), request->num_periods());
+			std::string timestamp = getISOTimestamp(wrapper->getLastCommandTimestamps());
+
 			auto* vector_response = response->mutable_impedances();
-			for (const auto& z : impedances) {
+			for (const auto& z : impedances.getImpedances()) {
 				ComplexNumber* cn = vector_response->add_values();
 				cn->set_real(z.real());
 				cn->set_imag(z.imag());
@@ -538,7 +536,7 @@ public:
 
 		try {
 			double potential = wrapper->getPotential();
-			std::string timestamp = getISOCurrentTimestamp();
+			std::string timestamp = getISOTimestamp(wrapper->getLastCommandTimestamps());
 			response->set_potential(potential);
 			response->set_timestamp(timestamp);
 		}
@@ -558,7 +556,7 @@ public:
 
 		try {
 			double current = wrapper->getCurrent();
-			std::string timestamp = getISOCurrentTimestamp();
+			std::string timestamp = getISOTimestamp(wrapper->getLastCommandTimestamps());
 			response->set_current(current);
 			response->set_timestamp(timestamp);
 		}
@@ -673,7 +671,7 @@ public:
 
 		try {
 			std::complex<double> impedance = wrapper->getImpedance();
-			std::string timestamp = getISOCurrentTimestamp();
+			std::string timestamp = getISOTimestamp(wrapper->getLastCommandTimestamps());
 			auto response_impedance = std::make_unique<ComplexNumber>();
 			response_impedance->set_real(impedance.real());
 			response_impedance->set_imag(impedance.imag());
@@ -708,40 +706,18 @@ private:
 		return std::complex<double>(real, imag);
 	}
 
-	//converts pad4 return string in the form of:
-	// impedance= -1.640e-02, 8.926e-03;pad01= -1.745e-01,-1.380e-01;pad02= -1.004e-01,-9.176e-02;pad03=  0.000e+00, 0.000e+00;
-	// pad04=  0.000e+00, 0.000e+00;pad05=  0.000e+00, 0.000e+00;pad06=  0.000e+00, 0.000e+00;pad07=  0.000e+00, 0.000e+00;
-	// pad08=  0.000e+00, 0.000e+00;pad09=  0.000e+00, 0.000e+00;pad10=  0.000e+00, 0.000e+00;pad11=  0.000e+00, 0.000e+00;
-	// pad12=  0.000e+00, 0.000e+00;pad13=  0.000e+00, 0.000e+00;pad14=  0.000e+00, 0.000e+00;pad15=  0.000e+00, 0.000e+00;
-	// pad16=  0.000e+00, 0.000e+00
-
-	std::vector<std::complex<double>> pad4StringToComplex(const std::string& str) {
-		double real = 0, imag = 0;
-		// Temporary to store the splitted string
-		std::string temp;
-
-		std::istringstream iss(str);
-
-		std::string inputLabel;
-
-		std::vector<std::complex<double>> parsedInputs;
-		//Reads a substring from iss(which holds the entire input string) up to the next ';' character.
-		while (getline(iss, temp, ';')) {
-			// Split single input
-			std::istringstream singleInput(temp);
-			// Extract label and values
-			std::getline(singleInput, inputLabel, '=');
-			singleInput >> real;
-			singleInput.ignore(); // Ignore the comma
-			singleInput >> imag;
-			parsedInputs.push_back(std::complex<double>(real, imag));
-		}
-
-		return parsedInputs;
-	}
-
 	std::string getISOCurrentTimestamp() {
 		const auto now = std::chrono::system_clock::now();
 		return std::format("{:%FT%TZ}", now);
 	}
+
+	// converts the midpoint of a request to an ISO timestamp with microsecond resolution
+	std::string getISOTimestamp(const TelegramTimestamps& timestamps) {
+		if (timestamps.sendTime == 0 || timestamps.receiveTime == 0) {
+			return getISOCurrentTimestamp();
+		}
+		const auto age = std::chrono::nanoseconds(getMonotonicTimeInNanoseconds() - timestamps.getMidpoint());
+		const auto time = std::chrono::floor<std::chrono::microseconds>(std::chrono::system_clock::now() - age);
+		return std::format("{:%FT%TZ}", time);
+	}
 };
@@ -0,0 +1,151 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "acqchannelrecorder.h"
+#include "thalesremotescriptwrapper.h"
+
+AcqChannelRecorder::AcqChannelRecorder(ThalesRemoteScriptWrapper* const wrapper) :
+    wrapper(wrapper),
+    period(std::chrono::milliseconds(1000)),
+    sampling_worker_is_running(false),
+    samplingWorker(nullptr)
+{
+
+}
+
+AcqChannelRecorder::~AcqChannelRecorder()
+{
+    this->stop();
+}
+
+void AcqChannelRecorder::start(const std::chrono::milliseconds period, size_t expectedSamples)
+{
+    this->stop();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->recording = Recording();
+        this->recording.time.reserve(expectedSamples);
+        for (auto& column : this->recording.channels)
+        {
+            column.reserve(expectedSamples);
+        }
+        this->lastError.clear();
+    }
+
+    this->period = period;
+    this->startTime = std::chrono::steady_clock::now();
+    this->sampling_worker_is_running = true;
+    this->samplingWorker = new std::thread(&AcqChannelRecorder::samplingJob, this);
+}
+
+void AcqChannelRecorder::stop()
+{
+    if (this->samplingWorker != nullptr)
+    {
+        this->sampling_worker_is_running = false;
+        this->samplingWorker->join();
+        delete this->samplingWorker;
+        this->samplingWorker = nullptr;
+    }
+}
+
+bool AcqChannelRecorder::isRunning() const
+{
+    return this->sampling_worker_is_running;
+}
+
+AcqChannelRecorder::Recording AcqChannelRecorder::getRecording() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->recording;
+}
+
+AcqChannelRecorder::Recording AcqChannelRecorder::takeRecording()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Recording retval = std::move(this->recording);
+    this->recording = Recording();
+    this->recording.enabledMask = retval.enabledMask;
+    return retval;
+}
+
+std::string AcqChannelRecorder::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->lastError;
+}
+
+void AcqChannelRecorder::samplingJob()
+{
+    auto nextSample = this->startTime;
+
+    while (this->sampling_worker_is_running == true)
+    {
+        try {
+            const AcqChannelValues values = this->wrapper->readAcqChannels();
+
+            /*
+             * The midpoint of the request is the best estimate for the time the device sampled the values.
+             */
+            const std::chrono::nanoseconds sampleTime(this->wrapper->getLastCommandTimestamps().getMidpoint());
+            const double seconds = std::chrono::duration<double>(sampleTime - this->startTime.time_since_epoch()).count();
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->recording.time.push_back(seconds);
+            for (int channel = 0; channel < AcqChannelValues::maximumNumberOfChannels; channel++)
+            {
+                this->recording.channels[channel].push_back(values.getValue(channel));
+            }
+            this->recording.enabledMask |= values.getEnabledMask();
+        }  catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->lastError = e.what();
+            this->sampling_worker_is_running = false;
+            break;
+        }
+
+        /*
+         * Fixed rate: if a read took longer than the period the missed sampling points are skipped
+         * instead of being read back to back.
+         */
+        nextSample += this->period;
+        const auto now = std::chrono::steady_clock::now();
+        if (nextSample < now)
+        {
+            const auto missed = (now - nextSample) / this->period + 1;
+            nextSample += missed * this->period;
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->recording.missedSamples += static_cast<unsigned long>(missed);
+        }
+
+        while (this->sampling_worker_is_running == true && std::chrono::steady_clock::now() < nextSample)
+        {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(nextSample - std::chrono::steady_clock::now(), std::chrono::milliseconds(50)));
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ACQCHANNELRECORDER_H
+#define ACQCHANNELRECORDER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "acqchannelvalues.h"
+
+class ThalesRemoteScriptWrapper;
+
+/** The AcqChannelRecorder class
+ *
+ *  Samples all enabled ACQ channels at a fixed rate into a columnar buffer.
+ *
+ *  Every sample costs exactly one round trip with ThalesRemoteScriptWrapper::readAcqChannels,
+ *  independent of the number of channels. The samples are stored column by column, one vector
+ *  with the time since start and one vector per ACQ channel.
+ *
+ *  While the recorder is running, the ThalesRemoteScriptWrapper must not be used by other threads.
+ */
+class AcqChannelRecorder
+{
+public:
+    class Recording
+    {
+    public:
+        std::vector<double> time;   /**< Time of the sample in seconds since the start of the recording. */
+        std::array<std::vector<double>, AcqChannelValues::maximumNumberOfChannels> channels; /**< One column per ACQ channel. */
+        uint32_t enabledMask = 0;   /**< Channels that delivered values in any sample. */
+        unsigned long missedSamples = 0; /**< Samples skipped because the previous read took longer than the period. */
+    };
+
+    /** Constructor. Needs a ThalesRemoteScriptWrapper connected to Thales. */
+    AcqChannelRecorder(ThalesRemoteScriptWrapper* const wrapper);
+    ~AcqChannelRecorder();
+
+    AcqChannelRecorder(const AcqChannelRecorder &) = delete;
+    AcqChannelRecorder& operator=(const AcqChannelRecorder &) = delete;
+
+    /** Start the sampling thread.
+     *
+     *  Previously recorded samples are discarded.
+     *
+     * \param  period The sampling period.
+     * \param  expectedSamples Number of samples for which memory is reserved in advance.
+     */
+    void start(const std::chrono::milliseconds period, size_t expectedSamples = 0);
+
+    /** Stop the sampling thread.
+     *
+     *  The recorded samples remain in the object.
+     */
+    void stop();
+
+    /** Check if the sampling thread is running.
+     *
+     * \return true if running.
+     */
+    bool isRunning() const;
+
+    /** Copy of the samples recorded so far.
+     *
+     * \return The recording.
+     */
+    Recording getRecording() const;
+
+    /** Move the recorded samples out of the object.
+     *
+     *  The internal buffer is empty afterwards, the recording continues.
+     *
+     * \return The recording.
+     */
+    Recording takeRecording();
+
+    /** Get the error message if the sampling thread was terminated by an exception.
+     *
+     * \return The error message or an empty string.
+     */
+    std::string getLastError() const;
+
+private:
+    /** Function which is executed as sampling thread. */
+    void samplingJob();
+
+    ThalesRemoteScriptWrapper* const wrapper;
+    std::chrono::milliseconds period;
+    std::chrono::steady_clock::time_point startTime;
+
+    std::atomic<bool> sampling_worker_is_running;
+    std::thread *samplingWorker;
+
+    mutable std::mutex mutex;
+    Recording recording;
+    std::string lastError;
+};
+
+#endif // ACQCHANNELRECORDER_H
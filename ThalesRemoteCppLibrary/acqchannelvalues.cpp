@@ -0,0 +1,134 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "acqchannelvalues.h"
+#include <charconv>
+#include <cmath>
+
+static const char* skipSpaces(const char* position, const char* end)
+{
+    while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+    {
+        position++;
+    }
+    return position;
+}
+
+AcqChannelValues::AcqChannelValues() :
+    enabledMask(0)
+{
+    this->values.fill(std::nan("1"));
+}
+
+AcqChannelValues AcqChannelValues::fromReply(std::string_view reply)
+{
+    AcqChannelValues retval;
+
+    const char* position = reply.data();
+    const char* end = reply.data() + reply.size();
+
+    while (position < end)
+    {
+        const char* open = position;
+        while (open < end && *open != '(' && *open != ';')
+        {
+            open++;
+        }
+
+        if (open < end && *open == '(')
+        {
+            int channel = -1;
+            auto indexResult = std::from_chars(open + 1, end, channel);
+            const char* equal = indexResult.ptr;
+            while (equal < end && *equal != '=' && *equal != ';')
+            {
+                equal++;
+            }
+
+            if (indexResult.ec == std::errc() && equal < end && *equal == '=')
+            {
+                const char* number = skipSpaces(equal + 1, end);
+                if (number < end && *number == '+')
+                {
+                    number++;
+                }
+                double value;
+                auto valueResult = std::from_chars(number, end, value);
+
+                if (valueResult.ec == std::errc() && channel >= 0 && channel < maximumNumberOfChannels)
+                {
+                    retval.values[channel] = value;
+                    retval.enabledMask |= (1u << channel);
+                }
+                open = (valueResult.ec == std::errc()) ? valueResult.ptr : number;
+            }
+            else
+            {
+                open = equal;
+            }
+        }
+
+        position = open;
+        while (position < end && *position != ';')
+        {
+            position++;
+        }
+        if (position < end)
+        {
+            position++;
+        }
+    }
+
+    return retval;
+}
+
+double AcqChannelValues::getValue(int channel) const
+{
+    if (channel < 0 || channel >= maximumNumberOfChannels)
+    {
+        return std::nan("1");
+    }
+    return this->values[channel];
+}
+
+bool AcqChannelValues::isChannelEnabled(int channel) const
+{
+    if (channel < 0 || channel >= maximumNumberOfChannels)
+    {
+        return false;
+    }
+    return (this->enabledMask & (1u << channel)) != 0;
+}
+
+uint32_t AcqChannelValues::getEnabledMask() const
+{
+    return this->enabledMask;
+}
+
+const std::array<double, AcqChannelValues::maximumNumberOfChannels>& AcqChannelValues::getValues() const
+{
+    return this->values;
+}
@@ -0,0 +1,95 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ACQCHANNELVALUES_H
+#define ACQCHANNELVALUES_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/** The AcqChannelValues class
+ *
+ *  Typed result of ThalesRemoteScriptWrapper::readAcqChannels.
+ *
+ *  Thales returns all active ACQ channels in one string like
+ *  "ACQVAL(0)= 2.632052e-01;ACQVAL(1)= 8.413594e-02;ACQVAL(2)= 5.338292e+01".
+ *  The values are stored in a fixed array indexed by the ACQ channel number.
+ *  Channels which were not part of the reply are not marked in the enabled mask and have the value NaN.
+ */
+class AcqChannelValues
+{
+public:
+    static constexpr int maximumNumberOfChannels = 32;
+
+    AcqChannelValues();
+
+    /** Parse the reply of the ANALOGALL command in a single pass.
+     *
+     *  The parser does not allocate memory. Unknown labels are ignored.
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The parsed channel values.
+     */
+    static AcqChannelValues fromReply(std::string_view reply);
+
+    /** Get the value of a channel.
+     *
+     * \param  channel The ACQ channel index.
+     *
+     * \return The value or NaN if the channel was not read.
+     */
+    double getValue(int channel) const;
+
+    /** Check if a channel was part of the reply.
+     *
+     * \param  channel The ACQ channel index.
+     *
+     * \return true if the channel is enabled.
+     */
+    bool isChannelEnabled(int channel) const;
+
+    /** Get the enabled mask.
+     *
+     *  Bit n is set if ACQ channel n was part of the reply.
+     *
+     * \return The enabled mask.
+     */
+    uint32_t getEnabledMask() const;
+
+    /** Get all channel values.
+     *
+     * \return Array indexed by the ACQ channel number.
+     */
+    const std::array<double, maximumNumberOfChannels>& getValues() const;
+
+private:
+    std::array<double, maximumNumberOfChannels> values;
+    uint32_t enabledMask;
+};
+
+#endif // ACQCHANNELVALUES_H
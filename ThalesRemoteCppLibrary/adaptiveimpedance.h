@@ -0,0 +1,61 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ADAPTIVEIMPEDANCE_H
+#define ADAPTIVEIMPEDANCE_H
+
+#include <complex>
+
+/** Settings of ThalesRemoteScriptWrapper::getImpedanceAdaptive.
+ *
+ *  The measurement starts with initialPeriods. After each measurement the estimate is compared with
+ *  the previous one. If they differ by more than relativeTolerance, the number of periods is doubled up to
+ *  maximumPeriods and the point is measured again.
+ */
+class AdaptiveImpedanceSettings
+{
+public:
+    int initialPeriods = 1;             /**< Number of periods of the first measurement. */
+    int maximumPeriods = 100;           /**< Upper limit for the number of periods of one measurement. */
+    int maximumMeasurements = 8;        /**< Upper limit for the number of measurements of the point. */
+    double relativeTolerance = 0.01;    /**< Allowed relative difference of two successive estimates. */
+    double targetConfidence = 0.0;      /**< Relative standard error of the mean at which the measurement is stopped early, 0 to disable. */
+};
+
+/** Result of ThalesRemoteScriptWrapper::getImpedanceAdaptive. */
+class AdaptiveImpedanceResult
+{
+public:
+    std::complex<double> impedance;     /**< Mean of all measurements, weighted with the number of periods. */
+    int measurements = 0;               /**< Number of impedance measurements. */
+    int totalPeriods = 0;               /**< Sum of the periods of all measurements. */
+    int lastPeriods = 0;                /**< Number of periods of the last measurement. */
+    double relativeDifference = 0.0;    /**< Relative difference of the last two estimates. */
+    double relativeStandardError = 0.0; /**< Relative standard error of the weighted mean, 0 if only one measurement. */
+    bool converged = false;             /**< true if the tolerance or the target confidence was reached. */
+};
+
+#endif // ADAPTIVEIMPEDANCE_H
@@ -0,0 +1,286 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "asyncmeasurement.h"
+#include "thalesremotescriptwrapper.h"
+#include "thalesremoteerror.h"
+
+/** Time between two checks if the response has arrived. */
+static constexpr std::chrono::milliseconds pollPeriod(50);
+
+AsyncMeasurement::AsyncMeasurement(ThalesRemoteScriptWrapper* const wrapper) :
+    wrapper(wrapper),
+    state(State::IDLE),
+    workstationBusy(false),
+    stopRequested(false),
+    cancelRequested(false),
+    worker(nullptr)
+{
+
+}
+
+AsyncMeasurement::~AsyncMeasurement()
+{
+    this->stopRequested = true;
+    this->wakeUp.notify_all();
+    this->wait();
+}
+
+void AsyncMeasurement::setProgressCallback(ProgressCallback callback)
+{
+    this->progressCallback = std::move(callback);
+}
+
+void AsyncMeasurement::setFinishedCallback(FinishedCallback callback)
+{
+    this->finishedCallback = std::move(callback);
+}
+
+void AsyncMeasurement::setErrorCallback(ErrorCallback callback)
+{
+    this->errorCallback = std::move(callback);
+}
+
+std::shared_future<std::string> AsyncMeasurement::start(std::string command,
+                                                        const std::chrono::milliseconds timeout,
+                                                        const std::chrono::milliseconds heartbeatPeriod)
+{
+    if (this->workstationBusy == true)
+    {
+        throw ThalesRemoteError("The workstation is still executing the previous command.");
+    }
+    this->wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->promise = std::promise<std::string>();
+        this->future = this->promise.get_future().share();
+    }
+
+    this->stopRequested = false;
+    this->cancelRequested = false;
+    this->state = State::RUNNING;
+    this->workstationBusy = true;
+
+    try {
+        this->wrapper->sendRemoteCommand(command);
+    }  catch (...) {
+        this->workstationBusy = false;
+        this->state = State::FAILED;
+        throw;
+    }
+
+    this->worker = new std::thread(&AsyncMeasurement::measurementJob, this, timeout, heartbeatPeriod);
+    return this->getFuture();
+}
+
+std::shared_future<std::string> AsyncMeasurement::startSequence(const std::chrono::milliseconds timeout)
+{
+    return this->start("DOSEQ", timeout);
+}
+
+std::shared_future<std::string> AsyncMeasurement::startEIS(const std::chrono::milliseconds timeout)
+{
+    return this->start("EIS", timeout);
+}
+
+std::shared_future<std::string> AsyncMeasurement::startCV(const std::chrono::milliseconds timeout)
+{
+    return this->start("CV", timeout);
+}
+
+std::shared_future<std::string> AsyncMeasurement::startIE(const std::chrono::milliseconds timeout)
+{
+    return this->start("IE", timeout);
+}
+
+void AsyncMeasurement::cancel()
+{
+    if (this->state == State::RUNNING)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->cancelRequested = true;
+        }
+        this->wakeUp.notify_all();
+    }
+}
+
+AsyncMeasurement::State AsyncMeasurement::getState() const
+{
+    return this->state;
+}
+
+std::shared_future<std::string> AsyncMeasurement::getFuture() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->future;
+}
+
+bool AsyncMeasurement::isWorkstationBusy() const
+{
+    return this->workstationBusy;
+}
+
+void AsyncMeasurement::wait()
+{
+    if (this->worker != nullptr)
+    {
+        this->worker->join();
+        delete this->worker;
+        this->worker = nullptr;
+    }
+}
+
+void AsyncMeasurement::fail(State state, const std::string& message)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->promise.set_exception(std::make_exception_ptr(ThalesRemoteError(message)));
+    }
+
+    if (this->errorCallback)
+    {
+        this->errorCallback(state, message);
+    }
+}
+
+void AsyncMeasurement::completeCancellation()
+{
+    if (this->cancelRequested == true)
+    {
+        this->cancelRequested = false;
+        State expected = State::RUNNING;
+        if (this->state.compare_exchange_strong(expected, State::CANCELLED))
+        {
+            this->fail(State::CANCELLED, "Measurement cancelled.");
+        }
+    }
+}
+
+void AsyncMeasurement::sleepUntil(std::chrono::steady_clock::time_point time)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->wakeUp.wait_until(lock, time, [this]() {
+        return this->stopRequested == true || this->cancelRequested == true;
+    });
+}
+
+void AsyncMeasurement::measurementJob(std::chrono::milliseconds timeout, std::chrono::milliseconds heartbeatPeriod)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    auto nextHeartbeat = startTime + heartbeatPeriod;
+
+    while (this->stopRequested == false)
+    {
+        this->completeCancellation();
+
+        try {
+            if (this->wrapper->isRemoteReplyAvailable() == true)
+            {
+                const std::string reply = this->wrapper->readRemoteReply();
+                this->workstationBusy = false;
+
+                /*
+                 * After a cancellation or timeout the response is only drained.
+                 */
+                State expected = State::RUNNING;
+                if (reply.find("ERROR") != std::string::npos)
+                {
+                    if (this->state.compare_exchange_strong(expected, State::FAILED))
+                    {
+                        this->fail(State::FAILED, reply);
+                    }
+                }
+                else if (this->state.compare_exchange_strong(expected, State::FINISHED))
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(this->mutex);
+                        this->promise.set_value(reply);
+                    }
+                    if (this->finishedCallback)
+                    {
+                        this->finishedCallback(reply);
+                    }
+                }
+                return;
+            }
+        }  catch (const std::exception& e) {
+            this->workstationBusy = false;
+            State expected = State::RUNNING;
+            if (this->state.compare_exchange_strong(expected, State::FAILED))
+            {
+                this->fail(State::FAILED, e.what());
+            }
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+
+        if (this->state == State::RUNNING && timeout > std::chrono::milliseconds::zero() && now - startTime >= timeout)
+        {
+            State expected = State::RUNNING;
+            if (this->state.compare_exchange_strong(expected, State::TIMEOUT))
+            {
+                this->fail(State::TIMEOUT, "Timeout while waiting for the measurement.");
+            }
+        }
+
+        if (this->state == State::RUNNING && heartbeatPeriod > std::chrono::milliseconds::zero() && now >= nextHeartbeat)
+        {
+            Progress progress;
+            progress.elapsed = now - startTime;
+            try {
+                progress.heartbeat = this->wrapper->getWorkstationHeartBeat();
+            }  catch (const std::exception&) {
+                progress.heartbeat = -1;
+            }
+
+            if (this->progressCallback)
+            {
+                this->progressCallback(progress);
+            }
+            nextHeartbeat = now + heartbeatPeriod;
+        }
+
+        if (this->state == State::RUNNING)
+        {
+            this->sleepUntil(std::chrono::steady_clock::now() + pollPeriod);
+        }
+        else
+        {
+            /*
+             * Draining the late response needs no fast reaction.
+             */
+            this->sleepUntil(std::chrono::steady_clock::now() + 4 * pollPeriod);
+        }
+    }
+
+    /*
+     * A cancellation immediately before the destruction still completes the future.
+     */
+    this->completeCancellation();
+}
@@ -0,0 +1,186 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASYNCMEASUREMENT_H
+#define ASYNCMEASUREMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class ThalesRemoteScriptWrapper;
+
+/** The AsyncMeasurement class
+ *
+ *  Starts a long running measurement like a sequence, EIS, CV or IE and returns immediately.
+ *
+ *  The command is sent to Remote Script and a worker thread waits for the response. While waiting,
+ *  the worker polls the heartbeat of the workstation and reports it as progress. Completion and errors
+ *  are delivered through callbacks and through a shared future.
+ *
+ *  Remote2 has no command to abort a running measurement. Cancellation and timeout therefore only stop
+ *  waiting: the future is completed with an error without waiting for the response, but the measurement
+ *  continues on the workstation. The worker thread reads and discards the late response, so that it is not mistaken for
+ *  the response of a following command. The wrapper must not be used for other Remote Script commands
+ *  until isWorkstationBusy() returns false.
+ *
+ *  The callbacks are executed in the worker thread.
+ */
+class AsyncMeasurement
+{
+public:
+    enum class State
+    {
+        IDLE,
+        RUNNING,
+        FINISHED,
+        FAILED,
+        TIMEOUT,
+        CANCELLED
+    };
+
+    class Progress
+    {
+    public:
+        std::chrono::duration<double> elapsed{0}; /**< Time since the measurement was started. */
+        int heartbeat = -1;                         /**< Heartbeat of the workstation in milliseconds or -1 if it could not be read. */
+    };
+
+    typedef std::function<void(const Progress&)> ProgressCallback;
+    typedef std::function<void(const std::string&)> FinishedCallback;
+    typedef std::function<void(State, const std::string&)> ErrorCallback;
+
+    /** Constructor. Needs a ThalesRemoteScriptWrapper connected to Thales. */
+    AsyncMeasurement(ThalesRemoteScriptWrapper* const wrapper);
+
+    /** The destructor waits for the worker thread, but does not wait for the response of a cancelled measurement. */
+    ~AsyncMeasurement();
+
+    AsyncMeasurement(const AsyncMeasurement &) = delete;
+    AsyncMeasurement& operator=(const AsyncMeasurement &) = delete;
+
+    /** Set the function which is called with each heartbeat poll. */
+    void setProgressCallback(ProgressCallback callback);
+
+    /** Set the function which is called with the response when the measurement is finished. */
+    void setFinishedCallback(FinishedCallback callback);
+
+    /** Set the function which is called with the final state and the message if the measurement failed, timed out or was cancelled. */
+    void setErrorCallback(ErrorCallback callback);
+
+    /** Start a Remote Script command.
+     *
+     * \param  command The Remote Script command which starts the measurement, e.g. "DOSEQ".
+     * \param  timeout Maximum time to wait for the response, zero to wait without limit.
+     * \param  heartbeatPeriod Period for reading the heartbeat, zero to disable progress events.
+     *
+     * \return The future which receives the response or an exception.
+     */
+    std::shared_future<std::string> start(std::string command,
+                                          const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero(),
+                                          const std::chrono::milliseconds heartbeatPeriod = std::chrono::milliseconds(1000));
+
+    /** Start the sequence selected with ThalesRemoteScriptWrapper::selectSequence. */
+    std::shared_future<std::string> startSequence(const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /** Start the EIS measurement configured in the wrapper. */
+    std::shared_future<std::string> startEIS(const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /** Start the CV measurement configured in the wrapper. */
+    std::shared_future<std::string> startCV(const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /** Start the IE measurement configured in the wrapper. */
+    std::shared_future<std::string> startIE(const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /** Stop waiting for the measurement.
+     *
+     *  The cancellation is handed to the worker thread, which completes the future with a ThalesRemoteError
+     *  and calls the error callback within one poll period. If the response arrives first, the measurement
+     *  finishes normally. The measurement on the workstation is not aborted.
+     */
+    void cancel();
+
+    /** Get the state of the measurement.
+     *
+     * \return The state.
+     */
+    State getState() const;
+
+    /** Get the future of the last started measurement.
+     *
+     * \return The future.
+     */
+    std::shared_future<std::string> getFuture() const;
+
+    /** Check if the workstation still executes the command.
+     *
+     *  This is also true after a cancellation or timeout, until the late response was received.
+     *
+     * \return true if the wrapper must not be used for other commands.
+     */
+    bool isWorkstationBusy() const;
+
+    /** Block until the worker thread has finished, including the draining of a late response. */
+    void wait();
+
+private:
+    /** Function which is executed as worker thread. */
+    void measurementJob(std::chrono::milliseconds timeout, std::chrono::milliseconds heartbeatPeriod);
+
+    /** Complete the future with an error and call the error callback. */
+    void fail(State state, const std::string& message);
+
+    /** Complete a requested cancellation, executed in the worker thread so the callbacks run there as well. */
+    void completeCancellation();
+
+    /** Sleep until the time point or until the object is destroyed. */
+    void sleepUntil(std::chrono::steady_clock::time_point time);
+
+    ThalesRemoteScriptWrapper* const wrapper;
+
+    ProgressCallback progressCallback;
+    FinishedCallback finishedCallback;
+    ErrorCallback errorCallback;
+
+    std::atomic<State> state;
+    std::atomic<bool> workstationBusy;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> cancelRequested;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::promise<std::string> promise;
+    std::shared_future<std::string> future;
+
+    std::thread *worker;
+};
+
+#endif // ASYNCMEASUREMENT_H
@@ -0,0 +1,140 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "clockalignmentestimator.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+ClockAlignmentEstimator::ClockAlignmentEstimator(size_t windowSize) :
+    windowSize(windowSize > 0 ? windowSize : 1),
+    referenceTime(0),
+    offsetAtReference(0.0),
+    drift(0.0),
+    uncertainty(0)
+{
+
+}
+
+void ClockAlignmentEstimator::addSample(const TelegramTimestamps& timestamps, int64_t deviceTime)
+{
+    const int64_t midpoint = timestamps.getMidpoint();
+    this->samples.push_back(Sample{midpoint, timestamps.getRoundTripTime(), deviceTime - midpoint});
+
+    while (this->samples.size() > this->windowSize)
+    {
+        this->samples.pop_front();
+    }
+
+    this->update();
+}
+
+void ClockAlignmentEstimator::reset()
+{
+    this->samples.clear();
+    this->referenceTime = 0;
+    this->offsetAtReference = 0.0;
+    this->drift = 0.0;
+    this->uncertainty = 0;
+}
+
+bool ClockAlignmentEstimator::isValid() const
+{
+    return this->samples.empty() == false;
+}
+
+double ClockAlignmentEstimator::getOffset(int64_t hostTime) const
+{
+    return this->offsetAtReference + this->drift * static_cast<double>(hostTime - this->referenceTime);
+}
+
+double ClockAlignmentEstimator::getDrift() const
+{
+    return this->drift * 1e6;
+}
+
+int64_t ClockAlignmentEstimator::getUncertainty() const
+{
+    return this->uncertainty;
+}
+
+int64_t ClockAlignmentEstimator::toDeviceTime(int64_t hostTime) const
+{
+    return hostTime + static_cast<int64_t>(std::llround(this->getOffset(hostTime)));
+}
+
+int64_t ClockAlignmentEstimator::toHostTime(int64_t deviceTime) const
+{
+    /*
+     * device = host + offset + drift * (host - reference), solved for host.
+     */
+    const double host = (static_cast<double>(deviceTime - this->referenceTime) - this->offsetAtReference) / (1.0 + this->drift);
+    return this->referenceTime + static_cast<int64_t>(std::llround(host));
+}
+
+void ClockAlignmentEstimator::update()
+{
+    std::vector<Sample> fastest(this->samples.begin(), this->samples.end());
+    const size_t count = std::max<size_t>(1, fastest.size() / 4);
+    std::nth_element(fastest.begin(), fastest.begin() + (count - 1), fastest.end(), [](const Sample& a, const Sample& b) {
+        return a.roundTripTime < b.roundTripTime;
+    });
+    fastest.resize(count);
+
+    this->uncertainty = this->samples.front().roundTripTime;
+    for (const auto& sample : this->samples)
+    {
+        this->uncertainty = std::min(this->uncertainty, sample.roundTripTime);
+    }
+    this->uncertainty /= 2;
+
+    /*
+     * Least squares fit of offset = a + b * (t - reference). The times are relative to the reference
+     * to keep the precision of the double calculation.
+     */
+    this->referenceTime = fastest.front().midpoint;
+    double sumT = 0.0;
+    double sumO = 0.0;
+    for (const auto& sample : fastest)
+    {
+        sumT += static_cast<double>(sample.midpoint - this->referenceTime);
+        sumO += static_cast<double>(sample.offset);
+    }
+    const double meanT = sumT / static_cast<double>(count);
+    const double meanO = sumO / static_cast<double>(count);
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (const auto& sample : fastest)
+    {
+        const double t = static_cast<double>(sample.midpoint - this->referenceTime) - meanT;
+        covariance += t * (static_cast<double>(sample.offset) - meanO);
+        variance += t * t;
+    }
+
+    this->drift = variance > 0.0 ? covariance / variance : 0.0;
+    this->offsetAtReference = meanO - this->drift * meanT;
+}
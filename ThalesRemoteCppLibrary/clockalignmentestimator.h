@@ -0,0 +1,129 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CLOCKALIGNMENTESTIMATOR_H
+#define CLOCKALIGNMENTESTIMATOR_H
+
+#include <cstdint>
+#include <deque>
+#include "timestampedvalue.h"
+
+/** The ClockAlignmentEstimator class
+ *
+ *  Estimates the offset and the drift between the host clock and the clock of the workstation.
+ *
+ *  Each sample is a request with its host send and receive time and a time value reported by the device in
+ *  the reply. As with NTP, the device time is assumed to belong to the midpoint of the round trip. Requests
+ *  with a long round trip time carry a large uncertainty, therefore only the fastest quarter of the samples
+ *  in the window is used. Offset and drift are fitted by least squares through these samples.
+ *
+ *  All times are in nanoseconds, host times from getMonotonicTimeInNanoseconds.
+ */
+class ClockAlignmentEstimator
+{
+public:
+    /** Constructor.
+     *
+     * \param  windowSize Number of samples which are kept for the estimation.
+     */
+    explicit ClockAlignmentEstimator(size_t windowSize = 64);
+
+    /** Add a sample.
+     *
+     * \param  timestamps Host send and receive time of the request.
+     * \param  deviceTime The time reported by the device in the reply, in nanoseconds.
+     */
+    void addSample(const TelegramTimestamps& timestamps, int64_t deviceTime);
+
+    /** Remove all samples. */
+    void reset();
+
+    /** Check if an estimate is available.
+     *
+     * \return true if at least one sample was added.
+     */
+    bool isValid() const;
+
+    /** Get the offset of the device clock at a host time.
+     *
+     * \param  hostTime The host time.
+     *
+     * \return Device time minus host time in nanoseconds.
+     */
+    double getOffset(int64_t hostTime) const;
+
+    /** Get the drift of the device clock relative to the host clock.
+     *
+     * \return The drift in parts per million.
+     */
+    double getDrift() const;
+
+    /** Get the uncertainty of the offset.
+     *
+     *  This is half of the smallest round trip time in the window.
+     *
+     * \return The uncertainty in nanoseconds.
+     */
+    int64_t getUncertainty() const;
+
+    /** Convert a host time to device time.
+     *
+     * \param  hostTime The host time.
+     *
+     * \return The device time.
+     */
+    int64_t toDeviceTime(int64_t hostTime) const;
+
+    /** Convert a device time to host time.
+     *
+     * \param  deviceTime The device time.
+     *
+     * \return The host time.
+     */
+    int64_t toHostTime(int64_t deviceTime) const;
+
+private:
+    class Sample
+    {
+    public:
+        int64_t midpoint;
+        int64_t roundTripTime;
+        int64_t offset;
+    };
+
+    /** Fit offset and drift through the fastest samples. */
+    void update();
+
+    size_t windowSize;
+    std::deque<Sample> samples;
+
+    int64_t referenceTime;
+    double offsetAtReference;
+    double drift;
+    int64_t uncertainty;
+};
+
+#endif // CLOCKALIGNMENTESTIMATOR_H
@@ -0,0 +1,350 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compressedfilearchive.h"
+#include <cstdio>
+#include <sstream>
+#include "zahnererror.h"
+
+/** Size of the buffers for compressed data. */
+static constexpr size_t blockSize = 64 * 1024;
+
+/** Name of the index file in the archive directory. */
+static const char* const indexFileName = "archive.idx";
+
+/** Window bits for deflate and inflate with gzip header. */
+static constexpr int gzipWindowBits = 15 + 16;
+
+static std::filesystem::path segmentFileName(const std::filesystem::path& directory, unsigned long segment)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "archive-%06lu.gz", segment);
+    return directory / name;
+}
+
+static std::vector<CompressedFileEntry> readIndex(const std::filesystem::path& directory)
+{
+    std::vector<CompressedFileEntry> retval;
+    std::ifstream index(directory / indexFileName);
+    std::string line;
+    while (std::getline(index, line))
+    {
+        std::istringstream fields(line);
+        CompressedFileEntry entry;
+        if (fields >> entry.segment >> entry.offset >> entry.compressedSize >> entry.size >> entry.crc)
+        {
+            fields.get();
+            std::getline(fields, entry.name, '\t');
+            std::getline(fields, entry.path);
+            retval.push_back(std::move(entry));
+        }
+    }
+    return retval;
+}
+
+CompressedFileArchive::CompressedFileArchive(std::filesystem::path directory, uint64_t maximumSegmentSize, int compressionLevel) :
+    directory(std::move(directory)),
+    maximumSegmentSize(maximumSegmentSize),
+    compressionLevel(compressionLevel),
+    segment(0),
+    segmentSize(0),
+    stream{},
+    streamActive(false),
+    outputBuffer(blockSize),
+    originalBytes(0),
+    compressedBytes(0)
+{
+    std::filesystem::create_directories(this->directory);
+
+    /*
+     * An existing archive is continued after its last segment, existing segments are never modified.
+     */
+    for (const auto& entry : readIndex(this->directory))
+    {
+        this->segment = std::max(this->segment, entry.segment);
+    }
+    while (std::filesystem::exists(segmentFileName(this->directory, this->segment + 1)))
+    {
+        this->segment++;
+    }
+
+    this->indexStream.open(this->directory / indexFileName, std::ofstream::app);
+    if (this->indexStream.is_open() == false)
+    {
+        throw ZahnerError("The archive index in " + this->directory.string() + " could not be opened.");
+    }
+}
+
+CompressedFileArchive::~CompressedFileArchive()
+{
+    if (this->streamActive == true)
+    {
+        this->end(false);
+    }
+    this->closeSegment();
+}
+
+void CompressedFileArchive::begin(const std::string& name, const std::string& path, size_t length)
+{
+    (void)length;
+
+    if (this->segmentStream.is_open() == false || this->segmentSize >= this->maximumSegmentSize)
+    {
+        this->closeSegment();
+        this->openSegment();
+    }
+
+    this->stream = z_stream{};
+    if (deflateInit2(&this->stream, this->compressionLevel, Z_DEFLATED, gzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw ZahnerError("The compression could not be initialized.");
+    }
+    this->streamActive = true;
+
+    this->current = CompressedFileEntry();
+    this->current.segment = this->segment;
+    this->current.offset = this->segmentSize;
+    this->current.crc = static_cast<uint32_t>(crc32(0L, Z_NULL, 0));
+    this->current.name = name;
+    this->current.path = path;
+}
+
+void CompressedFileArchive::write(const uint8_t* data, size_t size)
+{
+    while (size > 0)
+    {
+        /*
+         * zlib takes at most 4 GB per call.
+         */
+        const uInt part = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+        this->current.crc = static_cast<uint32_t>(crc32(this->current.crc, data, part));
+        this->current.size += part;
+
+        this->stream.next_in = const_cast<Bytef*>(data);
+        this->stream.avail_in = part;
+        this->deflateInput(Z_NO_FLUSH);
+
+        data += part;
+        size -= part;
+    }
+}
+
+void CompressedFileArchive::end(bool complete)
+{
+    if (this->streamActive == false)
+    {
+        return;
+    }
+
+    if (complete == true)
+    {
+        this->stream.next_in = nullptr;
+        this->stream.avail_in = 0;
+        this->deflateInput(Z_FINISH);
+    }
+    deflateEnd(&this->stream);
+    this->streamActive = false;
+
+    if (complete == false || this->segmentStream.fail() == true)
+    {
+        /*
+         * The incomplete member is overwritten by the next file or cut off when the segment is closed.
+         */
+        this->segmentStream.clear();
+        this->segmentStream.seekp(static_cast<std::streamoff>(this->current.offset));
+        this->segmentSize = this->current.offset;
+        return;
+    }
+
+    this->segmentStream.flush();
+    this->current.compressedSize = this->segmentSize - this->current.offset;
+    this->originalBytes += this->current.size;
+    this->compressedBytes += this->current.compressedSize;
+
+    this->indexStream << this->current.segment << '\t' << this->current.offset << '\t' << this->current.compressedSize << '\t'
+                      << this->current.size << '\t' << this->current.crc << '\t' << this->current.name << '\t' << this->current.path << '\n';
+    this->indexStream.flush();
+}
+
+uint64_t CompressedFileArchive::getOriginalBytes() const
+{
+    return this->originalBytes;
+}
+
+uint64_t CompressedFileArchive::getCompressedBytes() const
+{
+    return this->compressedBytes;
+}
+
+void CompressedFileArchive::openSegment()
+{
+    this->segment++;
+    this->segmentPath = segmentFileName(this->directory, this->segment);
+    this->segmentStream.open(this->segmentPath, std::ofstream::binary | std::ofstream::trunc);
+    if (this->segmentStream.is_open() == false)
+    {
+        throw ZahnerError("The archive segment " + this->segmentPath.string() + " could not be opened.");
+    }
+    this->segmentSize = 0;
+}
+
+void CompressedFileArchive::closeSegment()
+{
+    if (this->segmentStream.is_open() == false)
+    {
+        return;
+    }
+    this->segmentStream.close();
+
+    std::error_code error;
+    if (std::filesystem::file_size(this->segmentPath, error) != this->segmentSize)
+    {
+        std::filesystem::resize_file(this->segmentPath, this->segmentSize, error);
+    }
+}
+
+void CompressedFileArchive::deflateInput(int flush)
+{
+    int result;
+    do {
+        this->stream.next_out = this->outputBuffer.data();
+        this->stream.avail_out = static_cast<uInt>(this->outputBuffer.size());
+        result = deflate(&this->stream, flush);
+        if (result == Z_STREAM_ERROR)
+        {
+            throw ZahnerError("The compression failed.");
+        }
+
+        const size_t produced = this->outputBuffer.size() - this->stream.avail_out;
+        this->segmentStream.write(reinterpret_cast<const char*>(this->outputBuffer.data()), static_cast<std::streamsize>(produced));
+        this->segmentSize += produced;
+    } while (this->stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+}
+
+CompressedFileArchiveReader::CompressedFileArchiveReader(std::filesystem::path directory) :
+    directory(std::move(directory))
+{
+    this->reload();
+}
+
+void CompressedFileArchiveReader::reload()
+{
+    this->entries = readIndex(this->directory);
+}
+
+const std::vector<CompressedFileEntry>& CompressedFileArchiveReader::getEntries() const
+{
+    return this->entries;
+}
+
+const CompressedFileEntry* CompressedFileArchiveReader::find(const std::string& name) const
+{
+    for (auto entry = this->entries.rbegin(); entry != this->entries.rend(); ++entry)
+    {
+        if (entry->name == name)
+        {
+            return &(*entry);
+        }
+    }
+    return nullptr;
+}
+
+void CompressedFileArchiveReader::read(const CompressedFileEntry& entry, ReceivedFileSink& sink) const
+{
+    const auto segmentPath = segmentFileName(this->directory, entry.segment);
+    std::ifstream segmentStream(segmentPath, std::ifstream::binary);
+    if (segmentStream.is_open() == false)
+    {
+        throw ZahnerError("The archive segment " + segmentPath.string() + " could not be opened.");
+    }
+    segmentStream.seekg(static_cast<std::streamoff>(entry.offset));
+
+    z_stream stream{};
+    if (inflateInit2(&stream, gzipWindowBits) != Z_OK)
+    {
+        throw ZahnerError("The decompression could not be initialized.");
+    }
+
+    std::vector<uint8_t> input(blockSize);
+    std::vector<uint8_t> output(blockSize);
+    uint64_t remaining = entry.compressedSize;
+    uint64_t size = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    int result = Z_OK;
+
+    sink.begin(entry.name, entry.path, static_cast<size_t>(entry.size));
+    try {
+        while (result != Z_STREAM_END && remaining > 0)
+        {
+            segmentStream.read(reinterpret_cast<char*>(input.data()), static_cast<std::streamsize>(std::min<uint64_t>(remaining, input.size())));
+            const auto count = static_cast<uInt>(segmentStream.gcount());
+            if (count == 0)
+            {
+                break;
+            }
+            remaining -= count;
+            stream.next_in = input.data();
+            stream.avail_in = count;
+
+            do {
+                stream.next_out = output.data();
+                stream.avail_out = static_cast<uInt>(output.size());
+                result = inflate(&stream, Z_NO_FLUSH);
+                if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+                {
+                    throw ZahnerError("The archived file " + entry.name + " is damaged.");
+                }
+
+                const size_t produced = output.size() - stream.avail_out;
+                crc = crc32(crc, output.data(), static_cast<uInt>(produced));
+                size += produced;
+                sink.write(output.data(), produced);
+            } while (stream.avail_out == 0 && result != Z_STREAM_END);
+        }
+
+        if (result != Z_STREAM_END || size != entry.size || static_cast<uint32_t>(crc) != entry.crc)
+        {
+            throw ZahnerError("The archived file " + entry.name + " is damaged.");
+        }
+    }  catch (...) {
+        inflateEnd(&stream);
+        sink.end(false);
+        throw;
+    }
+    inflateEnd(&stream);
+    sink.end(true);
+}
+
+std::vector<uint8_t> CompressedFileArchiveReader::read(const CompressedFileEntry& entry) const
+{
+    std::vector<uint8_t> retval;
+    retval.reserve(static_cast<size_t>(entry.size));
+    CallbackFileSink sink([&retval](const std::string&, const uint8_t* data, size_t size) {
+        retval.insert(retval.end(), data, data + size);
+    });
+    this->read(entry, sink);
+    return retval;
+}
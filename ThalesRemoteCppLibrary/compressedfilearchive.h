@@ -0,0 +1,181 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COMPRESSEDFILEARCHIVE_H
+#define COMPRESSEDFILEARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "receivedfilesink.h"
+
+/** Entry of a file in a CompressedFileArchive. */
+class CompressedFileEntry
+{
+public:
+    unsigned long segment = 0;          /**< Number of the segment file. */
+    uint64_t offset = 0;                /**< Offset of the compressed data in the segment. */
+    uint64_t compressedSize = 0;        /**< Size of the compressed data in bytes. */
+    uint64_t size = 0;                  /**< Size of the original file in bytes. */
+    uint32_t crc = 0;                   /**< CRC-32 of the original file. */
+    std::string name;                   /**< Filename without path. */
+    std::string path;                   /**< Filename with path on the Thales computer. */
+};
+
+/** The CompressedFileArchive class
+ *
+ *  Sink which compresses the received files into a rolling archive.
+ *
+ *  Each chunk is deflated as soon as it arrives, so the file is never buffered completely. The files are
+ *  appended as gzip members to segment files "archive-000001.gz", "archive-000002.gz", ... in the archive
+ *  directory. When a segment exceeds the maximum segment size, the next file starts a new segment. Every
+ *  segment is a valid multi member gzip file. The position of each file is appended to the index file
+ *  "archive.idx", which is read by the CompressedFileArchiveReader.
+ *
+ *  Use it with ThalesFileInterface::setReceivedFileSink or ThalesFileInterface::acquireFiles.
+ *  The archive is only available if the library was built with zlib.
+ */
+class CompressedFileArchive : public ReceivedFileSink
+{
+public:
+    /** Constructor. An existing archive is continued with a new segment.
+     *
+     * \param  directory The directory of the archive, which is created if necessary.
+     * \param  maximumSegmentSize The size after which a new segment is started.
+     * \param  compressionLevel The zlib compression level from 1 to 9.
+     */
+    CompressedFileArchive(std::filesystem::path directory, uint64_t maximumSegmentSize = 1024ull * 1024 * 1024, int compressionLevel = 6);
+    ~CompressedFileArchive();
+
+    CompressedFileArchive(const CompressedFileArchive &) = delete;
+    CompressedFileArchive& operator=(const CompressedFileArchive &) = delete;
+
+    void begin(const std::string& name, const std::string& path, size_t length) override;
+    void write(const uint8_t* data, size_t size) override;
+    void end(bool complete) override;
+
+    /** Get the number of bytes of all archived files before compression.
+     *
+     * \return The number of bytes.
+     */
+    uint64_t getOriginalBytes() const;
+
+    /** Get the number of bytes of all archived files after compression.
+     *
+     * \return The number of bytes.
+     */
+    uint64_t getCompressedBytes() const;
+
+private:
+    /** Open the next segment file. */
+    void openSegment();
+
+    /** Close the current segment and cut off data of an incomplete file. */
+    void closeSegment();
+
+    /** Deflate the pending input and write the output to the segment. */
+    void deflateInput(int flush);
+
+    std::filesystem::path directory;
+    const uint64_t maximumSegmentSize;
+    const int compressionLevel;
+
+    unsigned long segment;
+    std::filesystem::path segmentPath;
+    std::ofstream segmentStream;
+    uint64_t segmentSize;
+
+    std::ofstream indexStream;
+
+    z_stream stream;
+    bool streamActive;
+    CompressedFileEntry current;
+    std::vector<uint8_t> outputBuffer;
+
+    uint64_t originalBytes;
+    uint64_t compressedBytes;
+};
+
+/** The CompressedFileArchiveReader class
+ *
+ *  Reads the files of a CompressedFileArchive.
+ *
+ *  The data is inflated block by block and passed to a sink, so a file can be read without holding it
+ *  completely in memory.
+ */
+class CompressedFileArchiveReader
+{
+public:
+    /** Constructor. Reads the index of the archive.
+     *
+     * \param  directory The directory of the archive.
+     */
+    CompressedFileArchiveReader(std::filesystem::path directory);
+
+    /** Read the index again, to see files which were added in the meantime. */
+    void reload();
+
+    /** Get all files of the archive in the order in which they were archived.
+     *
+     * \return The entries.
+     */
+    const std::vector<CompressedFileEntry>& getEntries() const;
+
+    /** Find the most recently archived file with a name.
+     *
+     * \param  name Filename without path.
+     *
+     * \return Pointer to the entry or nullptr.
+     */
+    const CompressedFileEntry* find(const std::string& name) const;
+
+    /** Decompress a file into a sink.
+     *
+     *  The size and the CRC-32 are checked, a ZahnerError is thrown if the data is damaged.
+     *
+     * \param  entry The entry of the file.
+     * \param  sink The destination of the data.
+     */
+    void read(const CompressedFileEntry& entry, ReceivedFileSink& sink) const;
+
+    /** Decompress a file into memory.
+     *
+     * \param  entry The entry of the file.
+     *
+     * \return The content of the file.
+     */
+    std::vector<uint8_t> read(const CompressedFileEntry& entry) const;
+
+private:
+    std::filesystem::path directory;
+    std::vector<CompressedFileEntry> entries;
+};
+
+#endif // COMPRESSEDFILEARCHIVE_H
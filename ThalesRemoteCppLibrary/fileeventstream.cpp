@@ -0,0 +1,75 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fileeventstream.h"
+
+FileEventStream::FileEventStream(ThalesFileInterface* const fileInterface, size_t capacity) :
+    fileInterface(fileInterface),
+    events(capacity),
+    closed(false)
+{
+    this->subscriptionId = this->fileInterface->subscribe([this](const ThalesFileInterface::FileEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->events.push(event);
+        }
+        this->eventAvailable.notify_all();
+    });
+}
+
+FileEventStream::~FileEventStream()
+{
+    this->fileInterface->unsubscribe(this->subscriptionId);
+    this->close();
+}
+
+bool FileEventStream::waitForEvent(ThalesFileInterface::FileEvent& event, const std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->eventAvailable.wait_for(lock, timeout, [this]() {
+        return this->events.size() > 0 || this->closed == true;
+    });
+    return this->events.pop(event);
+}
+
+bool FileEventStream::pop(ThalesFileInterface::FileEvent& event)
+{
+    return this->events.pop(event);
+}
+
+void FileEventStream::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+    }
+    this->eventAvailable.notify_all();
+}
+
+unsigned long FileEventStream::getDroppedEvents() const
+{
+    return this->events.getDropped();
+}
@@ -0,0 +1,97 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FILEEVENTSTREAM_H
+#define FILEEVENTSTREAM_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "ringbuffer.h"
+#include "thalesfileinterface.h"
+
+/** The FileEventStream class
+ *
+ *  Awaitable stream of the files received by the automatic file exchange of a ThalesFileInterface.
+ *
+ *  The stream subscribes to the file interface and buffers the events in a ring buffer. A consumer thread,
+ *  for example a gRPC server stream, waits for the next event instead of polling the received files.
+ */
+class FileEventStream
+{
+public:
+    /** Constructor.
+     *
+     * \param  fileInterface The file interface.
+     * \param  capacity The number of events the ring buffer can hold.
+     */
+    FileEventStream(ThalesFileInterface* const fileInterface, size_t capacity = 256);
+
+    /** The destructor removes the subscription. */
+    ~FileEventStream();
+
+    FileEventStream(const FileEventStream &) = delete;
+    FileEventStream& operator=(const FileEventStream &) = delete;
+
+    /** Wait for the next event.
+     *
+     * \param  event Receives the event.
+     * \param  timeout Maximum time to wait.
+     *
+     * \return false if no event was received within the timeout or the stream was closed.
+     */
+    bool waitForEvent(ThalesFileInterface::FileEvent& event, const std::chrono::milliseconds timeout);
+
+    /** Remove the oldest event without waiting.
+     *
+     * \param  event Receives the event.
+     *
+     * \return false if no event was available.
+     */
+    bool pop(ThalesFileInterface::FileEvent& event);
+
+    /** Wake up all waiting threads, waitForEvent returns false from now on if no event is buffered. */
+    void close();
+
+    /** Get the number of events which were overwritten before they were read.
+     *
+     * \return The number of dropped events.
+     */
+    unsigned long getDroppedEvents() const;
+
+private:
+    ThalesFileInterface* const fileInterface;
+    RingBuffer<ThalesFileInterface::FileEvent> events;
+    uint64_t subscriptionId;
+
+    std::mutex mutex;
+    std::condition_variable eventAvailable;
+    bool closed;
+};
+
+#endif // FILEEVENTSTREAM_H
@@ -0,0 +1,280 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "filewritebehind.h"
+#include <set>
+#include "zahnererror.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/** Synchronize the directory entries, so that renamed files survive a power loss. */
+static void syncDirectory(const std::filesystem::path& directory)
+{
+#ifdef _WIN32
+    (void)directory;
+#else
+    int handle = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (handle >= 0)
+    {
+        ::fsync(handle);
+        ::close(handle);
+    }
+#endif
+}
+
+double FileWriteBehind::Statistics::getThroughput() const
+{
+    if (this->writeTime.count() <= 0.0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(this->bytesWritten) / this->writeTime.count();
+}
+
+FileWriteBehind::FileWriteBehind(size_t maximumQueuedBytes, size_t maximumQueuedFiles) :
+    maximumQueuedBytes(maximumQueuedBytes),
+    maximumQueuedFiles(maximumQueuedFiles),
+    syncToDisk(false),
+    queuedBytes(0),
+    writing(false),
+    writer_worker_is_running(true)
+{
+    this->writerWorker = new std::thread(&FileWriteBehind::writerJob, this);
+}
+
+FileWriteBehind::~FileWriteBehind()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->writer_worker_is_running = false;
+    }
+    this->fileAvailable.notify_all();
+    this->writerWorker->join();
+    delete this->writerWorker;
+}
+
+void FileWriteBehind::enableSyncToDisk(bool enable)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->syncToDisk = enable;
+}
+
+void FileWriteBehind::enqueue(std::filesystem::path destination, std::vector<uint8_t> data,
+                              std::function<void(bool)> completion)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    auto hasSpace = [this, &data]() {
+        return this->queuedBytes == 0 ||
+               (this->queue.size() < this->maximumQueuedFiles &&
+                this->queuedBytes + data.size() <= this->maximumQueuedBytes);
+    };
+    if (hasSpace() == false)
+    {
+        this->statistics.blockedEnqueues++;
+        this->spaceAvailable.wait(lock, hasSpace);
+    }
+
+    this->queuedBytes += data.size();
+    this->statistics.maximumQueuedBytes = std::max(this->statistics.maximumQueuedBytes, this->queuedBytes);
+    this->queue.push_back(PendingFile{std::move(destination), std::move(data), std::move(completion)});
+    lock.unlock();
+
+    this->fileAvailable.notify_one();
+}
+
+void FileWriteBehind::flush()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->spaceAvailable.wait(lock, [this]() {
+        return this->queue.empty() == true && this->writing == false;
+    });
+}
+
+FileWriteBehind::Statistics FileWriteBehind::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->statistics;
+}
+
+void FileWriteBehind::writeFile(const std::filesystem::path& destination, const uint8_t* data, size_t size, bool syncToDisk)
+{
+    std::filesystem::path temporary = destination;
+    temporary += ".part";
+
+#ifdef _WIN32
+    int handle = ::_wopen(temporary.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int handle = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (handle < 0)
+    {
+        throw ZahnerError("The file " + temporary.string() + " could not be opened.");
+    }
+
+    bool ok = true;
+    size_t written = 0;
+    while (ok == true && written < size)
+    {
+        /*
+         * Write in large blocks, a single call may write less than requested.
+         */
+        const size_t block = std::min<size_t>(size - written, 1 << 30);
+#ifdef _WIN32
+        auto result = ::_write(handle, data + written, static_cast<unsigned int>(block));
+#else
+        auto result = ::write(handle, data + written, block);
+#endif
+        if (result <= 0)
+        {
+            ok = false;
+        }
+        else
+        {
+            written += static_cast<size_t>(result);
+        }
+    }
+
+    if (ok == true && syncToDisk == true)
+    {
+#ifdef _WIN32
+        ok = ::_commit(handle) == 0;
+#else
+        ok = ::fsync(handle) == 0;
+#endif
+    }
+
+#ifdef _WIN32
+    ok = (::_close(handle) == 0) && ok;
+#else
+    ok = (::close(handle) == 0) && ok;
+#endif
+
+    std::error_code error;
+    if (ok == true)
+    {
+        std::filesystem::rename(temporary, destination, error);
+    }
+    if (ok == false || error)
+    {
+        std::filesystem::remove(temporary, error);
+        throw ZahnerError("The file " + destination.string() + " could not be written.");
+    }
+}
+
+void FileWriteBehind::writerJob()
+{
+    while (true)
+    {
+        std::deque<PendingFile> batch;
+        bool sync;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->fileAvailable.wait(lock, [this]() {
+                return this->queue.empty() == false || this->writer_worker_is_running == false;
+            });
+
+            if (this->queue.empty() == true)
+            {
+                return;
+            }
+            batch.swap(this->queue);
+            this->writing = true;
+            sync = this->syncToDisk;
+        }
+
+        std::set<std::filesystem::path> directories;
+        std::vector<std::pair<std::function<void(bool)>, bool>> completions;
+        for (auto& file : batch)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::string message;
+            try {
+                writeFile(file.destination, file.data.data(), file.data.size(), sync);
+                directories.insert(file.destination.parent_path());
+            }  catch (const std::exception& e) {
+                message = e.what();
+            }
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->statistics.writeTime += duration;
+                if (message.empty() == true)
+                {
+                    this->statistics.filesWritten++;
+                    this->statistics.bytesWritten += file.data.size();
+                }
+                else
+                {
+                    this->statistics.failedFiles++;
+                    this->statistics.lastError = message;
+                }
+                this->queuedBytes -= file.data.size();
+            }
+            std::vector<uint8_t>().swap(file.data);
+            this->spaceAvailable.notify_all();
+
+            if (file.completion != nullptr)
+            {
+                completions.emplace_back(std::move(file.completion), message.empty() == true);
+            }
+        }
+
+        if (sync == true)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& directory : directories)
+            {
+                syncDirectory(directory);
+            }
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->statistics.writeTime += std::chrono::steady_clock::now() - start;
+        }
+
+        // The files are only reported as written once their directory entries are synchronized as well.
+        for (auto& completion : completions)
+        {
+            try {
+                completion.first(completion.second);
+            }  catch (...) {
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->writing = false;
+        }
+        this->spaceAvailable.notify_all();
+    }
+}
@@ -0,0 +1,154 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FILEWRITEBEHIND_H
+#define FILEWRITEBEHIND_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** The FileWriteBehind class
+ *
+ *  Writes files to the hard disk in a separate writer thread.
+ *
+ *  The files are appended to a bounded queue and the caller continues immediately, so a receiving thread is
+ *  not blocked by the hard disk. Only if the queue is full, enqueue waits until the writer has made space.
+ *
+ *  Each file is written with one large write call into a temporary file next to the destination, which is
+ *  then renamed to the destination. A reader therefore never sees a partially written file. Optionally the
+ *  data is synchronized to the disk before the rename. The directory entries are synchronized once per batch,
+ *  a batch being all files which were queued when the writer started.
+ */
+class FileWriteBehind
+{
+public:
+    class Statistics
+    {
+    public:
+        unsigned long filesWritten = 0;     /**< Number of files written successfully. */
+        unsigned long failedFiles = 0;      /**< Number of files which could not be written. */
+        unsigned long long bytesWritten = 0; /**< Number of bytes written successfully. */
+        std::chrono::duration<double> writeTime{0}; /**< Time the writer spent writing, including synchronization. */
+        size_t maximumQueuedBytes = 0;      /**< The largest number of bytes which were waiting in the queue. */
+        unsigned long blockedEnqueues = 0;  /**< Number of calls to enqueue which had to wait for space. */
+        std::string lastError;              /**< Message of the last error. */
+
+        /** Get the write throughput.
+         *
+         * \return The throughput in bytes per second of write time.
+         */
+        double getThroughput() const;
+    };
+
+    /** Constructor. Starts the writer thread.
+     *
+     * \param  maximumQueuedBytes The maximum number of bytes waiting in the queue.
+     * \param  maximumQueuedFiles The maximum number of files waiting in the queue.
+     */
+    FileWriteBehind(size_t maximumQueuedBytes = 64 * 1024 * 1024, size_t maximumQueuedFiles = 256);
+
+    /** The destructor writes the remaining files and stops the writer thread. */
+    ~FileWriteBehind();
+
+    FileWriteBehind(const FileWriteBehind &) = delete;
+    FileWriteBehind& operator=(const FileWriteBehind &) = delete;
+
+    /** Enable the synchronization of the data to the disk before the rename.
+     *
+     * \param  enable true to synchronize.
+     */
+    void enableSyncToDisk(bool enable = true);
+
+    /** Append a file to the queue.
+     *
+     *  A single file which is larger than the queue is accepted when no other file is waiting or being written.
+     *
+     * \param  destination The path of the file.
+     * \param  data The content, which is moved into the queue.
+     * \param  completion Optional function which is called by the writer thread after the file was written,
+     *                    with true on success and false if writing failed.
+     */
+    void enqueue(std::filesystem::path destination, std::vector<uint8_t> data,
+                 std::function<void(bool)> completion = nullptr);
+
+    /** Wait until all queued files are written. */
+    void flush();
+
+    /** Get the statistics.
+     *
+     * \return Copy of the statistics.
+     */
+    Statistics getStatistics() const;
+
+    /** Write a file atomically in the calling thread.
+     *
+     *  The data is written with one call into a temporary file, which is then renamed to the destination.
+     *
+     * \param  destination The path of the file.
+     * \param  data Pointer to the content.
+     * \param  size Size of the content in bytes.
+     * \param  syncToDisk true to synchronize the data to the disk before the rename.
+     */
+    static void writeFile(const std::filesystem::path& destination, const uint8_t* data, size_t size, bool syncToDisk);
+
+private:
+    class PendingFile
+    {
+    public:
+        std::filesystem::path destination;
+        std::vector<uint8_t> data;
+        std::function<void(bool)> completion;
+    };
+
+    /** Function which is executed as writer thread. */
+    void writerJob();
+
+    const size_t maximumQueuedBytes;
+    const size_t maximumQueuedFiles;
+    bool syncToDisk;
+
+    mutable std::mutex mutex;
+    std::condition_variable fileAvailable;
+    std::condition_variable spaceAvailable;
+    std::deque<PendingFile> queue;
+    size_t queuedBytes;
+    bool writing;
+    Statistics statistics;
+
+    bool writer_worker_is_running;
+    std::thread *writerWorker;
+};
+
+#endif // FILEWRITEBEHIND_H
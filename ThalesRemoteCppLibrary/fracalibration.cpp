@@ -0,0 +1,219 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fracalibration.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include "thalesremoteerror.h"
+
+/** Time between two readings while waiting for the value to settle. */
+static constexpr std::chrono::milliseconds settlePollPeriod(10);
+
+/** Least squares fit of y = slope * x + intercept. */
+static void fitLine(const std::vector<double>& x, const std::vector<double>& y, double& slope, double& intercept)
+{
+    const double count = static_cast<double>(x.size());
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        meanX += x[i];
+        meanY += y[i];
+    }
+    meanX /= count;
+    meanY /= count;
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        covariance += (x[i] - meanX) * (y[i] - meanY);
+        variance += (x[i] - meanX) * (x[i] - meanX);
+    }
+
+    if (variance <= 0.0)
+    {
+        throw ThalesRemoteError("The calibration staircase needs different set values.");
+    }
+
+    slope = covariance / variance;
+    intercept = meanY - slope * meanX;
+}
+
+FraCalibration::FraCalibration(ThalesRemoteScriptWrapper* const wrapper) :
+    wrapper(wrapper)
+{
+
+}
+
+FraCalibration::Result FraCalibration::run(const Settings& settings)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    Result result;
+    result.mode = settings.mode;
+
+    const int steps = std::max(2, settings.steps);
+    const double span = std::abs(settings.maximum - settings.minimum);
+    const double tolerance = settings.settleTolerance * (span > 0.0 ? span : 1.0);
+
+    for (int i = 0; i < steps; i++)
+    {
+        Step step;
+        step.setValue = settings.minimum + (settings.maximum - settings.minimum) * i / (steps - 1);
+        this->setValue(settings.mode, step.setValue);
+
+        /*
+         * Adaptive settling: read until a number of successive readings differ by less than the tolerance.
+         */
+        const auto stepStart = std::chrono::steady_clock::now();
+        double previous = this->readValue(settings.mode);
+        int stableReadings = 0;
+
+        while (stableReadings < settings.settleReadings)
+        {
+            if (std::chrono::steady_clock::now() - stepStart > settings.settleTimeout)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(settlePollPeriod);
+            const double reading = this->readValue(settings.mode);
+            stableReadings = std::abs(reading - previous) <= tolerance ? stableReadings + 1 : 0;
+            previous = reading;
+        }
+        step.settled = stableReadings >= settings.settleReadings;
+        step.settleTime = std::chrono::steady_clock::now() - stepStart;
+
+        const int averageReadings = std::max(1, settings.averageReadings);
+        double measured = 0.0;
+        double reference = 0.0;
+        for (int reading = 0; reading < averageReadings; reading++)
+        {
+            measured += this->readValue(settings.mode);
+            if (settings.referenceReader)
+            {
+                reference += settings.referenceReader();
+            }
+        }
+        step.measuredValue = measured / averageReadings;
+        step.referenceValue = settings.referenceReader ? reference / averageReadings : step.measuredValue;
+
+        result.steps.push_back(step);
+    }
+
+    this->setValue(settings.mode, 0.0);
+
+    std::vector<double> setValues;
+    std::vector<double> measuredValues;
+    std::vector<double> referenceValues;
+    for (const auto& step : result.steps)
+    {
+        setValues.push_back(step.setValue);
+        measuredValues.push_back(step.measuredValue);
+        referenceValues.push_back(step.referenceValue);
+    }
+
+    /*
+     * Input: read back = inputSlope * reference + inputIntercept. Solving
+     * reference = gain' * s + offset' with read back = gain * s + offset gives the corrected input scaling.
+     */
+    result.inputGain = settings.inputGain;
+    result.inputOffset = settings.inputOffset;
+    if (settings.referenceReader)
+    {
+        fitLine(referenceValues, measuredValues, result.inputSlope, result.inputIntercept);
+        if (result.inputSlope == 0.0)
+        {
+            throw ThalesRemoteError("The read back value does not follow the reference.");
+        }
+        result.inputGain = settings.inputGain / result.inputSlope;
+        result.inputOffset = (settings.inputOffset - result.inputIntercept) / result.inputSlope;
+    }
+
+    /*
+     * Output: actual = outputSlope * set + outputIntercept. With s = (set - offset) / gain the device
+     * behaves like actual = gain' * s + offset', which are the corrected output scaling.
+     */
+    fitLine(setValues, referenceValues, result.outputSlope, result.outputIntercept);
+    result.outputGain = settings.outputGain * result.outputSlope;
+    result.outputOffset = result.outputIntercept + result.outputSlope * settings.outputOffset;
+
+    double sumOfSquares = 0.0;
+    for (size_t i = 0; i < setValues.size(); i++)
+    {
+        const double deviation = referenceValues[i] - (result.outputSlope * setValues[i] + result.outputIntercept);
+        sumOfSquares += deviation * deviation;
+    }
+    result.residual = std::sqrt(sumOfSquares / static_cast<double>(setValues.size()));
+
+    result.duration = std::chrono::steady_clock::now() - startTime;
+    return result;
+}
+
+void FraCalibration::apply(const Result& result)
+{
+    this->wrapper->disableFraMode();
+
+    if (result.mode == PotentiostatMode::GALVANOSTATIC)
+    {
+        this->wrapper->setFraCurrentInputGain(result.inputGain);
+        this->wrapper->setFraCurrentInputOffset(result.inputOffset);
+        this->wrapper->setFraCurrentOutputGain(result.outputGain);
+        this->wrapper->setFraCurrentOutputOffset(result.outputOffset);
+    }
+    else
+    {
+        this->wrapper->setFraVoltageInputGain(result.inputGain);
+        this->wrapper->setFraVoltageInputOffset(result.inputOffset);
+        this->wrapper->setFraVoltageOutputGain(result.outputGain);
+        this->wrapper->setFraVoltageOutputOffset(result.outputOffset);
+    }
+
+    this->wrapper->enableFraMode();
+}
+
+void FraCalibration::setValue(PotentiostatMode mode, double value)
+{
+    if (mode == PotentiostatMode::GALVANOSTATIC)
+    {
+        this->wrapper->setCurrent(value);
+    }
+    else
+    {
+        this->wrapper->setPotential(value);
+    }
+}
+
+double FraCalibration::readValue(PotentiostatMode mode)
+{
+    if (mode == PotentiostatMode::GALVANOSTATIC)
+    {
+        return this->wrapper->getCurrent();
+    }
+    return this->wrapper->getPotential();
+}
@@ -0,0 +1,138 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FRACALIBRATION_H
+#define FRACALIBRATION_H
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "thalesremotescriptwrapper.h"
+
+/** The FraCalibration class
+ *
+ *  Calibration of the scaling of an external device which is controlled with the FRA probe.
+ *
+ *  The calibration drives a staircase of set values and waits at each step until the read back value has
+ *  settled, instead of waiting a fixed time. A straight line is fitted through the steps by least squares
+ *  and the corrected gain and offset are calculated from it.
+ *
+ *  Thales converts a set value x into the analog signal s = (x - offset) / gain and a measured signal s into
+ *  the value gain * s + offset. Without an external reference the input scaling is trusted and only the
+ *  output gain and offset are corrected, so that the read back value follows the set value. If a reference
+ *  reader is given, for example an external precision meter, the input scaling is corrected first against
+ *  the reference and the output scaling against the reference as well.
+ *
+ *  The channel depends on the mode: galvanostatic calibrates the current, potentiostatic the voltage.
+ *  The FRA mode must be enabled and the external device switched on before run is called.
+ */
+class FraCalibration
+{
+public:
+    class Settings
+    {
+    public:
+        PotentiostatMode mode = PotentiostatMode::GALVANOSTATIC; /**< Calibrated channel. */
+        double minimum = 0.0;               /**< First set value of the staircase. */
+        double maximum = 1.0;               /**< Last set value of the staircase. */
+        int steps = 8;                      /**< Number of steps, at least 2. */
+
+        double inputGain = 1.0;             /**< The input gain currently set. */
+        double inputOffset = 0.0;           /**< The input offset currently set. */
+        double outputGain = 1.0;            /**< The output gain currently set. */
+        double outputOffset = 0.0;          /**< The output offset currently set. */
+
+        double settleTolerance = 1e-3;      /**< Allowed change between readings, relative to the span of the staircase. */
+        int settleReadings = 3;             /**< Number of successive readings within the tolerance. */
+        int averageReadings = 3;            /**< Number of readings averaged after the value has settled. */
+        std::chrono::milliseconds settleTimeout{5000}; /**< Maximum wait time per step. */
+
+        std::function<double()> referenceReader; /**< Optional reader of an external reference meter. */
+    };
+
+    class Step
+    {
+    public:
+        double setValue = 0.0;              /**< The set value. */
+        double measuredValue = 0.0;         /**< Averaged value read back from Thales. */
+        double referenceValue = 0.0;        /**< Averaged reference value, or the read back value without reference. */
+        std::chrono::duration<double> settleTime{0}; /**< Time until the value was settled. */
+        bool settled = false;               /**< false if the settle timeout was reached. */
+    };
+
+    class Result
+    {
+    public:
+        std::vector<Step> steps;
+        PotentiostatMode mode = PotentiostatMode::GALVANOSTATIC;
+
+        double outputSlope = 1.0;           /**< Fitted slope of the actual value over the set value. */
+        double outputIntercept = 0.0;       /**< Fitted intercept of the actual value over the set value. */
+        double inputSlope = 1.0;            /**< Fitted slope of the read back value over the reference, 1 without reference. */
+        double inputIntercept = 0.0;        /**< Fitted intercept of the read back value over the reference. */
+        double residual = 0.0;              /**< RMS deviation of the steps from the fitted output line. */
+
+        double inputGain = 1.0;             /**< Corrected input gain. */
+        double inputOffset = 0.0;           /**< Corrected input offset. */
+        double outputGain = 1.0;            /**< Corrected output gain. */
+        double outputOffset = 0.0;          /**< Corrected output offset. */
+
+        std::chrono::duration<double> duration{0}; /**< Runtime of the calibration. */
+    };
+
+    /** Constructor. Needs a ThalesRemoteScriptWrapper connected to Thales. */
+    FraCalibration(ThalesRemoteScriptWrapper* const wrapper);
+
+    /** Drive the staircase and fit the scaling.
+     *
+     *  The set value is 0 after the calibration.
+     *
+     * \param  settings The settings.
+     *
+     * \return The result with the corrected gains and offsets.
+     */
+    Result run(const Settings& settings);
+
+    /** Set the corrected gains and offsets.
+     *
+     *  The FRA mode is disabled for this, because the settings may only be changed while it is disabled,
+     *  and enabled again afterwards.
+     *
+     * \param  result The result of run.
+     */
+    void apply(const Result& result);
+
+private:
+    /** Set the value of the calibrated channel. */
+    void setValue(PotentiostatMode mode, double value);
+
+    /** Read the value of the calibrated channel. */
+    double readValue(PotentiostatMode mode);
+
+    ThalesRemoteScriptWrapper* const wrapper;
+};
+
+#endif // FRACALIBRATION_H
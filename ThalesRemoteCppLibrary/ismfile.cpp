@@ -0,0 +1,170 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ismfile.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "zahnererror.h"
+
+static constexpr double pi = 3.14159265358979323846;
+
+/** Size of the 6 byte integers in the header. */
+static constexpr size_t integerSize = 6;
+
+/** Size of all values of one sample: four doubles and the significance. */
+static constexpr size_t sampleSize = 4 * sizeof(double) + sizeof(int16_t);
+
+static int64_t readInteger(const uint8_t* data)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < integerSize; i++)
+    {
+        value = (value << 8) | data[i];
+    }
+
+    /*
+     * Sign extension from 48 bit.
+     */
+    if ((value & (uint64_t(1) << 47)) != 0)
+    {
+        value |= ~((uint64_t(1) << 48) - 1);
+    }
+    return static_cast<int64_t>(value);
+}
+
+static const uint8_t* readDoubles(const uint8_t* data, std::vector<double>& column, size_t count)
+{
+    column.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t value = 0;
+        for (size_t byte = 0; byte < sizeof(double); byte++)
+        {
+            value = (value << 8) | *data++;
+        }
+        std::memcpy(&column[i], &value, sizeof(double));
+    }
+    return data;
+}
+
+IsmFile IsmFile::fromBinary(const uint8_t* data, size_t size)
+{
+    IsmFile retval;
+
+    if (size < 2 * integerSize)
+    {
+        throw ZahnerError("The ISM file is truncated.");
+    }
+
+    retval.version = readInteger(data);
+    const int64_t numberOfSamples = readInteger(data + integerSize) + 1;
+    data += 2 * integerSize;
+    size -= 2 * integerSize;
+
+    if (numberOfSamples < 0 || static_cast<uint64_t>(numberOfSamples) > size / sampleSize)
+    {
+        throw ZahnerError("The ISM file is truncated or not a spectrum.");
+    }
+    const auto count = static_cast<size_t>(numberOfSamples);
+
+    data = readDoubles(data, retval.frequencies, count);
+    data = readDoubles(data, retval.impedances, count);
+    data = readDoubles(data, retval.phases, count);
+    data = readDoubles(data, retval.times, count);
+
+    retval.significances.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        retval.significances[i] = static_cast<int16_t>((data[0] << 8) | data[1]);
+        data += sizeof(int16_t);
+    }
+
+    for (auto& phase : retval.phases)
+    {
+        phase *= 180.0 / pi;
+    }
+
+    return retval;
+}
+
+IsmFile IsmFile::fromBinary(const std::vector<uint8_t>& data)
+{
+    return fromBinary(data.data(), data.size());
+}
+
+IsmFile IsmFile::fromFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ifstream::binary);
+    if (file.is_open() == false)
+    {
+        throw ZahnerError("The file " + path.string() + " could not be opened.");
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return fromBinary(data);
+}
+
+int64_t IsmFile::getVersion() const
+{
+    return this->version;
+}
+
+size_t IsmFile::getNumberOfSamples() const
+{
+    return this->frequencies.size();
+}
+
+const std::vector<double>& IsmFile::getFrequencies() const
+{
+    return this->frequencies;
+}
+
+const std::vector<double>& IsmFile::getImpedances() const
+{
+    return this->impedances;
+}
+
+const std::vector<double>& IsmFile::getPhases() const
+{
+    return this->phases;
+}
+
+const std::vector<double>& IsmFile::getTimes() const
+{
+    return this->times;
+}
+
+const std::vector<int16_t>& IsmFile::getSignificances() const
+{
+    return this->significances;
+}
+
+std::complex<double> IsmFile::getComplexImpedance(size_t index) const
+{
+    return std::polar(this->impedances.at(index), this->phases.at(index) * pi / 180.0);
+}
@@ -0,0 +1,141 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ISMFILE_H
+#define ISMFILE_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/** The IsmFile class
+ *
+ *  Reader for the binary impedance spectra (.ism) which Thales writes and which are received with the
+ *  ThalesFileInterface.
+ *
+ *  The layout is the one read by the IsmImport class of Zahner's zahner_analysis package. All values are
+ *  big endian:
+ *  - version as 6 byte integer
+ *  - number of samples - 1 as 6 byte integer
+ *  - frequency in Hz, impedance in Ohm, phase in rad and measurement time in s as 8 byte doubles, each
+ *    column stored as one block with all samples
+ *  - significance as 2 byte integers
+ *
+ *  The metadata after the significance block is not read. The columns are stored as contiguous arrays
+ *  in the order of the file, the phase is converted to degrees like in the text export.
+ */
+class IsmFile
+{
+public:
+    /** Parse a spectrum from memory, e.g. ThalesFileInterface::FileObject::binary_data.
+     *
+     *  A ZahnerError is thrown if the data is truncated or not a spectrum.
+     *
+     * \param  data Pointer to the data.
+     * \param  size Size of the data in bytes.
+     *
+     * \return The parsed spectrum.
+     */
+    static IsmFile fromBinary(const uint8_t* data, size_t size);
+
+    /** Parse a spectrum from memory.
+     *
+     * \param  data The content of the file.
+     *
+     * \return The parsed spectrum.
+     */
+    static IsmFile fromBinary(const std::vector<uint8_t>& data);
+
+    /** Read and parse a spectrum file.
+     *
+     * \param  path The path of the .ism file.
+     *
+     * \return The parsed spectrum.
+     */
+    static IsmFile fromFile(const std::filesystem::path& path);
+
+    /** Get the version of the file format.
+     *
+     * \return The version number.
+     */
+    int64_t getVersion() const;
+
+    /** Get the number of samples of the spectrum.
+     *
+     * \return The number of samples.
+     */
+    size_t getNumberOfSamples() const;
+
+    /** Get the frequencies.
+     *
+     * \return The frequencies in Hz.
+     */
+    const std::vector<double>& getFrequencies() const;
+
+    /** Get the absolute values of the impedance.
+     *
+     * \return The impedances in Ohm.
+     */
+    const std::vector<double>& getImpedances() const;
+
+    /** Get the phases.
+     *
+     * \return The phases in degree.
+     */
+    const std::vector<double>& getPhases() const;
+
+    /** Get the time stamps of the samples.
+     *
+     * \return The times in seconds since the start of the measurement.
+     */
+    const std::vector<double>& getTimes() const;
+
+    /** Get the significances of the samples.
+     *
+     * \return The significances.
+     */
+    const std::vector<int16_t>& getSignificances() const;
+
+    /** Get the complex impedance of a sample.
+     *
+     * \param  index The index of the sample.
+     *
+     * \return The complex impedance in Ohm.
+     */
+    std::complex<double> getComplexImpedance(size_t index) const;
+
+private:
+    int64_t version = 0;
+    std::vector<double> frequencies;
+    std::vector<double> impedances;
+    std::vector<double> phases;
+    std::vector<double> times;
+    std::vector<int16_t> significances;
+};
+
+#endif // ISMFILE_H
@@ -0,0 +1,286 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "measurementjobqueue.h"
+#include "thalesremotescriptwrapper.h"
+
+MeasurementJobQueue::MeasurementJobQueue(ThalesRemoteScriptWrapper* const wrapper, ThalesFileInterface* const fileInterface) :
+    wrapper(wrapper),
+    fileInterface(fileInterface),
+    nextId(1),
+    activeJobs(0),
+    workers_are_running(true)
+{
+    this->measurementWorker = new std::thread(&MeasurementJobQueue::measurementJob, this);
+    this->fileWorker = new std::thread(&MeasurementJobQueue::fileJob, this);
+}
+
+MeasurementJobQueue::~MeasurementJobQueue()
+{
+    this->cancelAll();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->workers_are_running = false;
+    }
+    this->queueChanged.notify_all();
+
+    this->measurementWorker->join();
+    delete this->measurementWorker;
+    this->fileWorker->join();
+    delete this->fileWorker;
+}
+
+void MeasurementJobQueue::setJobFinishedCallback(JobFinishedCallback callback)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->jobFinishedCallback = std::move(callback);
+}
+
+uint64_t MeasurementJobQueue::submit(Job job)
+{
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        id = this->nextId++;
+        const QueueKey key(-job.priority, id);
+        this->queuedJobs.emplace(key, QueuedJob{id, std::move(job), std::chrono::steady_clock::now()});
+    }
+    this->queueChanged.notify_all();
+    return id;
+}
+
+bool MeasurementJobQueue::cancel(uint64_t id)
+{
+    JobResult result;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto it = this->queuedJobs.begin();
+        while (it != this->queuedJobs.end() && it->second.id != id)
+        {
+            ++it;
+        }
+
+        if (it == this->queuedJobs.end())
+        {
+            return false;
+        }
+
+        result.id = id;
+        result.name = it->second.job.name;
+        result.priority = it->second.job.priority;
+        result.state = JobState::CANCELLED;
+        result.queueTime = std::chrono::steady_clock::now() - it->second.submitTime;
+        this->queuedJobs.erase(it);
+    }
+
+    this->finishJob(std::move(result));
+    return true;
+}
+
+void MeasurementJobQueue::cancelAll()
+{
+    std::map<QueueKey, QueuedJob> cancelledJobs;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        cancelledJobs.swap(this->queuedJobs);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& [key, queuedJob] : cancelledJobs)
+    {
+        JobResult result;
+        result.id = queuedJob.id;
+        result.name = queuedJob.job.name;
+        result.priority = queuedJob.job.priority;
+        result.state = JobState::CANCELLED;
+        result.queueTime = now - queuedJob.submitTime;
+        this->finishJob(std::move(result));
+    }
+}
+
+size_t MeasurementJobQueue::getNumberOfQueuedJobs() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->queuedJobs.size();
+}
+
+void MeasurementJobQueue::waitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->queueChanged.wait(lock, [this]() {
+        return this->queuedJobs.empty() && this->pendingFiles.empty() && this->activeJobs == 0;
+    });
+}
+
+std::vector<MeasurementJobQueue::JobResult> MeasurementJobQueue::takeResults()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::vector<JobResult> retval = std::move(this->results);
+    this->results.clear();
+    return retval;
+}
+
+void MeasurementJobQueue::finishJob(JobResult result)
+{
+    JobFinishedCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        callback = this->jobFinishedCallback;
+    }
+
+    if (callback)
+    {
+        callback(result);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->results.push_back(std::move(result));
+    }
+    this->queueChanged.notify_all();
+}
+
+void MeasurementJobQueue::measurementJob()
+{
+    while (true)
+    {
+        QueuedJob queuedJob;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->queueChanged.wait(lock, [this]() {
+                return this->workers_are_running == false || this->queuedJobs.empty() == false;
+            });
+
+            if (this->queuedJobs.empty() == true)
+            {
+                return;
+            }
+
+            /*
+             * The map is ordered by priority and id, so the first element is the next job.
+             */
+            auto node = this->queuedJobs.extract(this->queuedJobs.begin());
+            queuedJob = std::move(node.mapped());
+            this->activeJobs++;
+        }
+
+        JobResult result;
+        result.id = queuedJob.id;
+        result.name = queuedJob.job.name;
+        result.priority = queuedJob.job.priority;
+
+        const auto jobStart = std::chrono::steady_clock::now();
+        result.queueTime = jobStart - queuedJob.submitTime;
+        auto measureStart = jobStart;
+
+        try {
+            if (queuedJob.job.setup)
+            {
+                queuedJob.job.setup(*this->wrapper);
+            }
+            measureStart = std::chrono::steady_clock::now();
+            result.setupTime = measureStart - jobStart;
+
+            if (queuedJob.job.measure)
+            {
+                result.reply = queuedJob.job.measure(*this->wrapper);
+            }
+            result.state = JobState::FINISHED;
+        }  catch (const std::exception& e) {
+            result.state = JobState::FAILED;
+            result.error = e.what();
+        }
+        const auto measureEnd = std::chrono::steady_clock::now();
+        result.measureTime = measureEnd - measureStart;
+
+        if (result.state == JobState::FINISHED && queuedJob.job.fileToAcquire.empty() == false)
+        {
+            if (this->fileInterface == nullptr)
+            {
+                result.state = JobState::FAILED;
+                result.error = "No file interface for the acquisition of " + queuedJob.job.fileToAcquire + ".";
+            }
+            else
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->pendingFiles.push_back(PendingFile{std::move(result), queuedJob.job.fileToAcquire, measureEnd});
+                    this->activeJobs--;
+                }
+                this->queueChanged.notify_all();
+                continue;
+            }
+        }
+
+        this->finishJob(std::move(result));
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->activeJobs--;
+        }
+        this->queueChanged.notify_all();
+    }
+}
+
+void MeasurementJobQueue::fileJob()
+{
+    while (true)
+    {
+        PendingFile pendingFile;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->queueChanged.wait(lock, [this]() {
+                return this->pendingFiles.empty() == false || (this->workers_are_running == false && this->activeJobs == 0);
+            });
+
+            if (this->pendingFiles.empty() == true)
+            {
+                return;
+            }
+
+            pendingFile = std::move(this->pendingFiles.front());
+            this->pendingFiles.pop_front();
+            this->activeJobs++;
+        }
+
+        try {
+            pendingFile.result.file = this->fileInterface->acquireFile(pendingFile.filename);
+        }  catch (const std::exception& e) {
+            pendingFile.result.state = JobState::FAILED;
+            pendingFile.result.error = e.what();
+        }
+        pendingFile.result.fileTime = std::chrono::steady_clock::now() - pendingFile.measureEnd;
+
+        this->finishJob(std::move(pendingFile.result));
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->activeJobs--;
+        }
+        this->queueChanged.notify_all();
+    }
+}
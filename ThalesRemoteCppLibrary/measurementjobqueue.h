@@ -0,0 +1,203 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MEASUREMENTJOBQUEUE_H
+#define MEASUREMENTJOBQUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "thalesfileinterface.h"
+
+class ThalesRemoteScriptWrapper;
+
+/** The MeasurementJobQueue class
+ *
+ *  Queue of measurement jobs for one instrument with its own worker thread.
+ *
+ *  A job consists of up to three steps: a setup function which sets the parameters, a measure function
+ *  which starts the measurement and returns the response, and the name of a file which is acquired with
+ *  the ThalesFileInterface afterwards.
+ *
+ *  The worker always starts the queued job with the highest priority. Jobs with the same priority are
+ *  executed in the order they were submitted. A running measurement cannot be interrupted, because
+ *  Remote2 has no abort command, so a job with a higher priority preempts the others at the next job
+ *  boundary.
+ *
+ *  The file acquisition uses the separate connection of the ThalesFileInterface and runs in a second
+ *  thread. The setup of the next job therefore starts as soon as the previous measurement returned.
+ *
+ *  While the queue exists, the ThalesRemoteScriptWrapper must not be used by other threads.
+ */
+class MeasurementJobQueue
+{
+public:
+    typedef std::function<void(ThalesRemoteScriptWrapper&)> SetupFunction;
+    typedef std::function<std::string(ThalesRemoteScriptWrapper&)> MeasureFunction;
+
+    class Job
+    {
+    public:
+        std::string name;               /**< Name of the job. */
+        int priority = 0;               /**< Jobs with higher priority are executed first. */
+        SetupFunction setup;            /**< Optional function which sets the parameters. */
+        MeasureFunction measure;        /**< Optional function which executes the measurement. */
+        std::string fileToAcquire;      /**< Optional file which is acquired after the measurement. */
+    };
+
+    enum class JobState
+    {
+        FINISHED,
+        FAILED,
+        CANCELLED
+    };
+
+    class JobResult
+    {
+    public:
+        uint64_t id = 0;                /**< Id returned by submit. */
+        std::string name;               /**< Name of the job. */
+        int priority = 0;               /**< Priority of the job. */
+        JobState state = JobState::FINISHED;
+        std::string reply;              /**< Return value of the measure function. */
+        std::string error;              /**< Error message if the job failed. */
+        ThalesFileInterface::FileObject file; /**< The acquired file, if a file was requested. */
+        std::chrono::duration<double> queueTime{0};    /**< Time from submit until the start of the job. */
+        std::chrono::duration<double> setupTime{0};    /**< Runtime of the setup function. */
+        std::chrono::duration<double> measureTime{0};  /**< Runtime of the measure function. */
+        std::chrono::duration<double> fileTime{0};     /**< Time from the end of the measurement until the file was received. */
+    };
+
+    typedef std::function<void(const JobResult&)> JobFinishedCallback;
+
+    /** Constructor.
+     *
+     * \param  wrapper Wrapper of the instrument.
+     * \param  fileInterface File interface for file acquisition or nullptr if no files are acquired.
+     */
+    MeasurementJobQueue(ThalesRemoteScriptWrapper* const wrapper, ThalesFileInterface* const fileInterface = nullptr);
+
+    /** The destructor cancels the queued jobs and waits for the running job. */
+    ~MeasurementJobQueue();
+
+    MeasurementJobQueue(const MeasurementJobQueue &) = delete;
+    MeasurementJobQueue& operator=(const MeasurementJobQueue &) = delete;
+
+    /** Set the function which is called when a job is finished, failed or cancelled.
+     *
+     *  The function is called from the worker threads.
+     */
+    void setJobFinishedCallback(JobFinishedCallback callback);
+
+    /** Add a job to the queue.
+     *
+     * \param  job The job.
+     *
+     * \return The id of the job.
+     */
+    uint64_t submit(Job job);
+
+    /** Remove a job from the queue.
+     *
+     *  Only jobs which have not yet started can be cancelled.
+     *
+     * \param  id The id of the job.
+     *
+     * \return true if the job was removed from the queue.
+     */
+    bool cancel(uint64_t id);
+
+    /** Remove all jobs which have not yet started. */
+    void cancelAll();
+
+    /** Get the number of jobs which have not yet started.
+     *
+     * \return The number of queued jobs.
+     */
+    size_t getNumberOfQueuedJobs() const;
+
+    /** Block until all jobs are finished. */
+    void waitUntilIdle();
+
+    /** Move the results of the finished jobs out of the object.
+     *
+     * \return The results in the order the jobs were finished.
+     */
+    std::vector<JobResult> takeResults();
+
+private:
+    class QueuedJob
+    {
+    public:
+        uint64_t id;
+        Job job;
+        std::chrono::steady_clock::time_point submitTime;
+    };
+
+    class PendingFile
+    {
+    public:
+        JobResult result;
+        std::string filename;
+        std::chrono::steady_clock::time_point measureEnd;
+    };
+
+    /** Key of the job map, the first element is the highest priority and the oldest job. */
+    typedef std::pair<int, uint64_t> QueueKey;
+
+    /** Function which is executed as worker thread for the measurements. */
+    void measurementJob();
+
+    /** Function which is executed as worker thread for the file acquisition. */
+    void fileJob();
+
+    /** Store a result and call the callback. */
+    void finishJob(JobResult result);
+
+    ThalesRemoteScriptWrapper* const wrapper;
+    ThalesFileInterface* const fileInterface;
+    JobFinishedCallback jobFinishedCallback;
+
+    mutable std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::map<QueueKey, QueuedJob> queuedJobs;
+    std::deque<PendingFile> pendingFiles;
+    std::vector<JobResult> results;
+    uint64_t nextId;
+    int activeJobs;
+    bool workers_are_running;
+
+    std::thread *measurementWorker;
+    std::thread *fileWorker;
+};
+
+#endif // MEASUREMENTJOBQUEUE_H
@@ -0,0 +1,173 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "measurementorchestrator.h"
+#include <thread>
+#include "thalesremoteconnection.h"
+#include "thalesremotescriptwrapper.h"
+#include "termconnectionerror.h"
+#include "thalesremoteerror.h"
+
+MeasurementOrchestrator::MeasurementOrchestrator()
+{
+
+}
+
+MeasurementOrchestrator::~MeasurementOrchestrator()
+{
+    this->ownedWrappers.clear();
+    for (auto& connection : this->ownedConnections)
+    {
+        connection->disconnectFromTerm();
+    }
+}
+
+int MeasurementOrchestrator::addWorkstation(std::string address, std::string connectionName)
+{
+    auto connection = std::make_unique<ZenniumConnection>();
+
+    if (connection->connectToTerm(address, connectionName) == false)
+    {
+        throw TermConnectionError("Could not connect to " + address + ".");
+    }
+
+    auto wrapper = std::make_unique<ThalesRemoteScriptWrapper>(connection.get());
+    wrapper->forceThalesIntoRemoteScript();
+
+    this->workstations.push_back(wrapper.get());
+    this->ownedConnections.push_back(std::move(connection));
+    this->ownedWrappers.push_back(std::move(wrapper));
+    return static_cast<int>(this->workstations.size()) - 1;
+}
+
+int MeasurementOrchestrator::addWorkstation(ThalesRemoteScriptWrapper* const wrapper)
+{
+    this->workstations.push_back(wrapper);
+    return static_cast<int>(this->workstations.size()) - 1;
+}
+
+int MeasurementOrchestrator::getNumberOfWorkstations() const
+{
+    return static_cast<int>(this->workstations.size());
+}
+
+ThalesRemoteScriptWrapper& MeasurementOrchestrator::getWorkstation(int workstation)
+{
+    return *this->workstations.at(workstation);
+}
+
+void MeasurementOrchestrator::addJob(std::string name, int workstation, int device, JobFunction job)
+{
+    if (workstation < 0 || workstation >= this->getNumberOfWorkstations())
+    {
+        throw ThalesRemoteError("Job " + name + " uses an unknown workstation.");
+    }
+
+    this->jobs.push_back(Job{std::move(name), workstation, device, std::move(job)});
+}
+
+void MeasurementOrchestrator::clearJobs()
+{
+    this->jobs.clear();
+}
+
+MeasurementOrchestrator::Report MeasurementOrchestrator::run()
+{
+    Report report;
+    report.jobs.resize(this->jobs.size());
+    report.busyTime.resize(this->workstations.size());
+
+    std::vector<std::vector<size_t>> jobsPerWorkstation(this->workstations.size());
+    for (size_t i = 0; i < this->jobs.size(); i++)
+    {
+        jobsPerWorkstation[this->jobs[i].workstation].push_back(i);
+    }
+
+    /*
+     * Every thread only writes the results of its own jobs and its own busy time, so the
+     * report needs no locking.
+     */
+    const auto runStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t workstation = 0; workstation < jobsPerWorkstation.size(); workstation++)
+    {
+        if (jobsPerWorkstation[workstation].empty() == false)
+        {
+            threads.emplace_back(&MeasurementOrchestrator::workstationJob, this, static_cast<int>(workstation),
+                                 std::cref(jobsPerWorkstation[workstation]), runStart, std::ref(report));
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    report.totalDuration = std::chrono::steady_clock::now() - runStart;
+    for (const auto& result : report.jobs)
+    {
+        if (result.success == false)
+        {
+            report.failedJobs++;
+        }
+    }
+    return report;
+}
+
+void MeasurementOrchestrator::workstationJob(int workstation, const std::vector<size_t>& jobIndices, std::chrono::steady_clock::time_point runStart, Report& report)
+{
+    ThalesRemoteScriptWrapper& wrapper = *this->workstations[workstation];
+    int selectedDevice = -1;
+
+    for (size_t index : jobIndices)
+    {
+        const Job& job = this->jobs[index];
+        JobResult& result = report.jobs[index];
+        result.name = job.name;
+        result.workstation = workstation;
+        result.device = job.device;
+
+        const auto jobStart = std::chrono::steady_clock::now();
+        try {
+            if (job.device >= 0 && job.device != selectedDevice)
+            {
+                selectedDevice = -1;
+                wrapper.selectPotentiostat(job.device);
+                selectedDevice = job.device;
+            }
+            result.reply = job.function(wrapper);
+            result.success = true;
+        }  catch (const std::exception& e) {
+            result.error = e.what();
+            result.success = false;
+        }
+        const auto jobEnd = std::chrono::steady_clock::now();
+
+        result.startTime = jobStart - runStart;
+        result.duration = jobEnd - jobStart;
+        report.busyTime[workstation] += result.duration;
+    }
+}
@@ -0,0 +1,164 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MEASUREMENTORCHESTRATOR_H
+#define MEASUREMENTORCHESTRATOR_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ZenniumConnection;
+class ThalesRemoteScriptWrapper;
+
+/** The MeasurementOrchestrator class
+ *
+ *  Runs measurement jobs on several workstations in parallel.
+ *
+ *  Each workstation is one connection to Term with one ThalesRemoteScriptWrapper. A workstation can
+ *  have several potentiostats, which are selected with ThalesRemoteScriptWrapper::selectPotentiostat.
+ *  Because a workstation only executes one Remote2 command at a time, the jobs of one workstation are
+ *  executed one after another in the order they were added. Jobs of different workstations run
+ *  in parallel, with one thread per workstation.
+ *
+ *  The results and the timing of all jobs are collected in one Report.
+ */
+class MeasurementOrchestrator
+{
+public:
+    /** Function executed for a job. The return value is stored as reply in the job result. */
+    typedef std::function<std::string(ThalesRemoteScriptWrapper&)> JobFunction;
+
+    class JobResult
+    {
+    public:
+        std::string name;           /**< Name of the job. */
+        int workstation = -1;       /**< Index of the workstation. */
+        int device = -1;            /**< Potentiostat index or -1 if no potentiostat was selected. */
+        bool success = false;       /**< false if the job threw an exception. */
+        std::string reply;          /**< Return value of the job function. */
+        std::string error;          /**< Error message if the job failed. */
+        std::chrono::duration<double> startTime{0};    /**< Start of the job relative to the start of the run. */
+        std::chrono::duration<double> duration{0};     /**< Runtime of the job including the potentiostat selection. */
+    };
+
+    class Report
+    {
+    public:
+        std::vector<JobResult> jobs;                        /**< Results in the order the jobs were added. */
+        std::vector<std::chrono::duration<double>> busyTime; /**< Summed job runtime per workstation. */
+        std::chrono::duration<double> totalDuration{0};     /**< Wall clock time of the whole run. */
+        int failedJobs = 0;                                 /**< Number of jobs which threw an exception. */
+    };
+
+    MeasurementOrchestrator();
+    ~MeasurementOrchestrator();
+
+    MeasurementOrchestrator(const MeasurementOrchestrator &) = delete;
+    MeasurementOrchestrator& operator=(const MeasurementOrchestrator &) = delete;
+
+    /** Connect to a workstation and add it to the orchestrator.
+     *
+     *  The orchestrator owns the connection and disconnects it in the destructor.
+     *
+     * \param  address The hostname or ip-address of the host running Term.
+     * \param  connectionName The name of the connection.
+     *
+     * \return The index of the workstation.
+     */
+    int addWorkstation(std::string address, std::string connectionName = "ScriptRemote");
+
+    /** Add an already connected workstation.
+     *
+     *  The wrapper must stay valid as long as the orchestrator is used and must not be used
+     *  by other threads while run() is executed.
+     *
+     * \param  wrapper The wrapper of the workstation.
+     *
+     * \return The index of the workstation.
+     */
+    int addWorkstation(ThalesRemoteScriptWrapper* const wrapper);
+
+    /** Get the number of workstations.
+     *
+     * \return The number of workstations.
+     */
+    int getNumberOfWorkstations() const;
+
+    /** Get the wrapper of a workstation.
+     *
+     * \param  workstation The index of the workstation.
+     *
+     * \return The wrapper.
+     */
+    ThalesRemoteScriptWrapper& getWorkstation(int workstation);
+
+    /** Add a job.
+     *
+     *  If device is not negative, the potentiostat is selected before the job is executed. The
+     *  selection is skipped if the previous job of the workstation used the same potentiostat.
+     *
+     * \param  name Name of the job for the report.
+     * \param  workstation The index of the workstation.
+     * \param  device The potentiostat index or -1 to use the currently selected potentiostat.
+     * \param  job The function which is executed.
+     */
+    void addJob(std::string name, int workstation, int device, JobFunction job);
+
+    /** Remove all jobs which were added. */
+    void clearJobs();
+
+    /** Execute all jobs and wait until they are finished.
+     *
+     *  An exception thrown by a job is stored in its result, the following jobs of the workstation
+     *  are still executed.
+     *
+     * \return The report of the run.
+     */
+    Report run();
+
+private:
+    class Job
+    {
+    public:
+        std::string name;
+        int workstation;
+        int device;
+        JobFunction function;
+    };
+
+    /** Function which is executed as thread for each workstation. */
+    void workstationJob(int workstation, const std::vector<size_t>& jobIndices, std::chrono::steady_clock::time_point runStart, Report& report);
+
+    std::vector<std::unique_ptr<ZenniumConnection>> ownedConnections;
+    std::vector<std::unique_ptr<ThalesRemoteScriptWrapper>> ownedWrappers;
+    std::vector<ThalesRemoteScriptWrapper*> workstations;
+    std::vector<Job> jobs;
+};
+
+#endif // MEASUREMENTORCHESTRATOR_H
@@ -0,0 +1,389 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "monitoringscheduler.h"
+#include <algorithm>
+#include "thalesremotescriptwrapper.h"
+#include "thalesremoteerror.h"
+
+MonitoringScheduler::MonitoringScheduler(const std::chrono::milliseconds tick) :
+    tick(tick > std::chrono::milliseconds::zero() ? tick : std::chrono::milliseconds(1)),
+    startTime(std::chrono::steady_clock::now()),
+    nextId(1),
+    scheduler_is_running(false),
+    workers_are_running(true),
+    schedulerWorker(nullptr)
+{
+
+}
+
+MonitoringScheduler::~MonitoringScheduler()
+{
+    this->stop();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->workers_are_running = false;
+        for (auto& workstation : this->workstations)
+        {
+            workstation->dispatches.clear();
+        }
+    }
+
+    for (auto& workstation : this->workstations)
+    {
+        workstation->dispatchAvailable.notify_all();
+    }
+
+    for (auto& workstation : this->workstations)
+    {
+        workstation->worker->join();
+        delete workstation->worker;
+    }
+}
+
+int MonitoringScheduler::addWorkstation(ThalesRemoteScriptWrapper* const wrapper)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto workstation = std::make_unique<Workstation>();
+    workstation->wrapper = wrapper;
+    workstation->worker = new std::thread(&MonitoringScheduler::workstationJob, this, workstation.get());
+    this->workstations.push_back(std::move(workstation));
+    return static_cast<int>(this->workstations.size()) - 1;
+}
+
+uint64_t MonitoringScheduler::addTask(Task task)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (task.workstation < 0 || task.workstation >= static_cast<int>(this->workstations.size()))
+    {
+        throw ThalesRemoteError("Task " + task.name + " uses an unknown workstation.");
+    }
+
+    const uint64_t id = this->nextId++;
+
+    ScheduledTask scheduledTask;
+    scheduledTask.metrics.id = id;
+    scheduledTask.metrics.name = task.name;
+    scheduledTask.nextTick = this->wheel.getCurrentTick() + this->durationToTicks(task.offset);
+    scheduledTask.task = std::move(task);
+
+    this->wheel.schedule(id, scheduledTask.nextTick);
+    this->tasks.emplace(id, std::move(scheduledTask));
+    return id;
+}
+
+bool MonitoringScheduler::removeTask(uint64_t id)
+{
+    /*
+     * The timer stays in the wheel and is ignored when it expires.
+     */
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->tasks.erase(id) > 0;
+}
+
+void MonitoringScheduler::start()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (this->schedulerWorker == nullptr)
+    {
+        /*
+         * The time before the start or while the scheduler was stopped is not counted as lateness or as missed
+         * deadlines: the wheel restarts at tick 0 now and the tasks keep their remaining delay.
+         */
+        const uint64_t baseTick = this->wheel.getCurrentTick();
+        this->wheel = TimingWheel();
+        for (auto& [id, scheduledTask] : this->tasks)
+        {
+            scheduledTask.nextTick = scheduledTask.nextTick > baseTick ? scheduledTask.nextTick - baseTick : 0;
+            this->wheel.schedule(id, scheduledTask.nextTick);
+        }
+        this->startTime = std::chrono::steady_clock::now();
+
+        this->scheduler_is_running = true;
+        this->schedulerWorker = new std::thread(&MonitoringScheduler::schedulerJob, this);
+    }
+}
+
+void MonitoringScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->scheduler_is_running = false;
+    }
+    this->stateChanged.notify_all();
+
+    if (this->schedulerWorker != nullptr)
+    {
+        this->schedulerWorker->join();
+        delete this->schedulerWorker;
+        this->schedulerWorker = nullptr;
+    }
+
+    /*
+     * The scheduler thread has stopped, so no new dispatches are added while waiting for the workstations.
+     */
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->workstationsIdle.wait(lock, [this]() {
+        for (const auto& workstation : this->workstations)
+        {
+            if (workstation->executing == true || workstation->dispatches.empty() == false)
+            {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+std::vector<MonitoringScheduler::TaskMetrics> MonitoringScheduler::getMetrics() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::vector<TaskMetrics> retval;
+    retval.reserve(this->tasks.size());
+    for (const auto& [id, scheduledTask] : this->tasks)
+    {
+        retval.push_back(scheduledTask.metrics);
+    }
+    return retval;
+}
+
+std::chrono::steady_clock::time_point MonitoringScheduler::tickToTime(uint64_t tick) const
+{
+    return this->startTime + this->tick * static_cast<int64_t>(tick);
+}
+
+uint64_t MonitoringScheduler::durationToTicks(std::chrono::milliseconds duration) const
+{
+    if (duration <= std::chrono::milliseconds::zero())
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>((duration + this->tick - std::chrono::milliseconds(1)) / this->tick);
+}
+
+void MonitoringScheduler::schedulerJob()
+{
+    std::vector<uint64_t> expired;
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (this->scheduler_is_running == true)
+    {
+        const uint64_t nextTick = this->wheel.getCurrentTick() + 1;
+        this->stateChanged.wait_until(lock, this->tickToTime(nextTick), [this]() {
+            return this->scheduler_is_running == false;
+        });
+
+        if (this->scheduler_is_running == false)
+        {
+            break;
+        }
+
+        /*
+         * If the thread was delayed, all ticks up to now are processed at once.
+         */
+        const auto elapsed = std::chrono::steady_clock::now() - this->startTime;
+        const uint64_t currentTick = std::max<uint64_t>(nextTick, static_cast<uint64_t>(elapsed / this->tick));
+
+        expired.clear();
+        this->wheel.advance(currentTick, expired);
+
+        for (uint64_t id : expired)
+        {
+            auto it = this->tasks.find(id);
+            if (it == this->tasks.end())
+            {
+                continue;
+            }
+
+            ScheduledTask& scheduledTask = it->second;
+            const auto scheduledTime = this->tickToTime(scheduledTask.nextTick);
+
+            if (scheduledTask.pending == true)
+            {
+                scheduledTask.metrics.missedDeadlines++;
+            }
+            else
+            {
+                scheduledTask.pending = true;
+                Workstation& workstation = *this->workstations[scheduledTask.task.workstation];
+                workstation.dispatches.push_back(Dispatch{id, scheduledTime});
+                workstation.dispatchAvailable.notify_one();
+            }
+
+            /*
+             * Fixed rate: the next execution is relative to the scheduled time, not to the start.
+             * Periods which have already passed completely are counted as missed.
+             */
+            const uint64_t periodTicks = std::max<uint64_t>(1, this->durationToTicks(scheduledTask.task.period));
+            scheduledTask.nextTick += periodTicks;
+            while (scheduledTask.nextTick < currentTick)
+            {
+                scheduledTask.nextTick += periodTicks;
+                scheduledTask.metrics.missedDeadlines++;
+            }
+            this->wheel.schedule(id, scheduledTask.nextTick);
+        }
+    }
+}
+
+void MonitoringScheduler::workstationJob(Workstation* workstation)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true)
+    {
+        workstation->dispatchAvailable.wait(lock, [this, workstation]() {
+            return this->workers_are_running == false || workstation->dispatches.empty() == false;
+        });
+
+        if (workstation->dispatches.empty() == true)
+        {
+            return;
+        }
+
+        std::deque<Dispatch> batch;
+        batch.swap(workstation->dispatches);
+        workstation->executing = true;
+
+        /*
+         * Coalescing: the dispatches are executed grouped by setup key, in the order of the first
+         * dispatch of each group. The setup of a group is executed only once.
+         */
+        std::vector<std::string> setupKeys;
+        std::vector<std::vector<Dispatch>> groups;
+        for (const auto& dispatch : batch)
+        {
+            auto it = this->tasks.find(dispatch.id);
+            if (it == this->tasks.end())
+            {
+                continue;
+            }
+
+            const std::string& key = it->second.task.setupKey;
+            size_t group = groups.size();
+            if (key.empty() == false)
+            {
+                for (size_t i = 0; i < setupKeys.size(); i++)
+                {
+                    if (setupKeys[i] == key)
+                    {
+                        group = i;
+                        break;
+                    }
+                }
+            }
+
+            if (group == groups.size())
+            {
+                setupKeys.push_back(key);
+                groups.emplace_back();
+            }
+            groups[group].push_back(dispatch);
+        }
+
+        for (const auto& group : groups)
+        {
+            bool setupDone = false;
+
+            for (const auto& dispatch : group)
+            {
+                auto it = this->tasks.find(dispatch.id);
+                if (it == this->tasks.end())
+                {
+                    continue;
+                }
+
+                /*
+                 * The functions are copied, so the task can be removed while it is executed.
+                 */
+                const TaskFunction setup = it->second.task.setup;
+                const TaskFunction measure = it->second.task.measure;
+                const bool coalesced = setupDone == true && setup;
+
+                lock.unlock();
+
+                const auto executionStart = std::chrono::steady_clock::now();
+                std::string error;
+                try {
+                    if (setup && setupDone == false)
+                    {
+                        setup(*workstation->wrapper);
+                    }
+                    setupDone = true;
+
+                    if (measure)
+                    {
+                        measure(*workstation->wrapper);
+                    }
+                }  catch (const std::exception& e) {
+                    error = e.what();
+                    if (error.empty() == true)
+                    {
+                        error = "Unknown error.";
+                    }
+                }
+                const auto executionEnd = std::chrono::steady_clock::now();
+
+                lock.lock();
+
+                it = this->tasks.find(dispatch.id);
+                if (it == this->tasks.end())
+                {
+                    continue;
+                }
+
+                ScheduledTask& scheduledTask = it->second;
+                TaskMetrics& metrics = scheduledTask.metrics;
+                const std::chrono::duration<double> lateness = std::max<std::chrono::steady_clock::duration>(
+                    executionStart - dispatch.scheduledTime, std::chrono::steady_clock::duration::zero());
+
+                scheduledTask.pending = false;
+                metrics.executions++;
+                metrics.lastLateness = lateness;
+                metrics.maximumLateness = std::max(metrics.maximumLateness, lateness);
+                metrics.totalLateness += lateness;
+                metrics.lastDuration = executionEnd - executionStart;
+                if (coalesced == true)
+                {
+                    metrics.coalescedSetups++;
+                }
+                if (error.empty() == false)
+                {
+                    metrics.failures++;
+                    metrics.lastError = error;
+                }
+            }
+        }
+
+        workstation->executing = false;
+        this->workstationsIdle.notify_all();
+    }
+}
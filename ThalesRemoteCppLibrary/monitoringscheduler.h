@@ -0,0 +1,205 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MONITORINGSCHEDULER_H
+#define MONITORINGSCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "timingwheel.h"
+
+class ThalesRemoteScriptWrapper;
+
+/** The MonitoringScheduler class
+ *
+ *  Executes periodic monitoring tasks, like reading the open circuit potential every 10 s or measuring
+ *  an impedance every minute, on a set of workstations.
+ *
+ *  The due times are kept in a TimingWheel, so hundreds of tasks with different periods can be scheduled
+ *  with a constant cost per tick. The connections to the workstations stay open for the lifetime of the
+ *  scheduler, each workstation has a worker thread which executes the due tasks one after another.
+ *
+ *  Tasks of the same workstation which are due at the same time and have the same setup key are coalesced:
+ *  the setup function is executed once and then the measure functions of all these tasks.
+ *
+ *  The tasks are scheduled at a fixed rate. If a task is still waiting or running when it is due again,
+ *  the execution is skipped and counted as missed deadline. The lateness of the start compared to the
+ *  scheduled time is recorded for each task.
+ */
+class MonitoringScheduler
+{
+public:
+    typedef std::function<void(ThalesRemoteScriptWrapper&)> TaskFunction;
+
+    class Task
+    {
+    public:
+        std::string name;                       /**< Name of the task for the metrics. */
+        int workstation = 0;                    /**< Index of the workstation. */
+        std::chrono::milliseconds period{1000}; /**< Period of the task. */
+        std::chrono::milliseconds offset{0};    /**< Delay of the first execution after the task was added. */
+        std::string setupKey;                   /**< Tasks with the same non empty key share the setup. */
+        TaskFunction setup;                     /**< Optional function which sets the parameters. */
+        TaskFunction measure;                   /**< Function which executes the measurement. */
+    };
+
+    class TaskMetrics
+    {
+    public:
+        uint64_t id = 0;                        /**< Id returned by addTask. */
+        std::string name;                       /**< Name of the task. */
+        unsigned long executions = 0;           /**< Number of executions. */
+        unsigned long failures = 0;             /**< Number of executions which threw an exception. */
+        unsigned long missedDeadlines = 0;      /**< Number of skipped executions. */
+        unsigned long coalescedSetups = 0;      /**< Number of executions which reused the setup of another task. */
+        std::chrono::duration<double> lastLateness{0};     /**< Lateness of the last execution. */
+        std::chrono::duration<double> maximumLateness{0};  /**< Maximum lateness. */
+        std::chrono::duration<double> totalLateness{0};    /**< Sum of the lateness of all executions. */
+        std::chrono::duration<double> lastDuration{0};     /**< Runtime of the last execution. */
+        std::string lastError;                  /**< Message of the last failed execution. */
+    };
+
+    /** Constructor.
+     *
+     * \param  tick Resolution of the scheduler.
+     */
+    MonitoringScheduler(const std::chrono::milliseconds tick = std::chrono::milliseconds(100));
+    ~MonitoringScheduler();
+
+    MonitoringScheduler(const MonitoringScheduler &) = delete;
+    MonitoringScheduler& operator=(const MonitoringScheduler &) = delete;
+
+    /** Add a connected workstation and start its worker thread.
+     *
+     *  The wrapper must stay valid as long as the scheduler exists and must not be used by other threads.
+     *
+     * \param  wrapper The wrapper of the workstation.
+     *
+     * \return The index of the workstation.
+     */
+    int addWorkstation(ThalesRemoteScriptWrapper* const wrapper);
+
+    /** Add a periodic task.
+     *
+     * \param  task The task.
+     *
+     * \return The id of the task.
+     */
+    uint64_t addTask(Task task);
+
+    /** Remove a task. An execution which is already running is completed.
+     *
+     * \param  id The id of the task.
+     *
+     * \return true if the task existed.
+     */
+    bool removeTask(uint64_t id);
+
+    /** Start the scheduler thread.
+     *
+     *  The offsets and periods of the tasks continue from the start, the time before the start or since the
+     *  last stop is not counted as lateness or missed deadline.
+     */
+    void start();
+
+    /** Stop the scheduler thread and wait until the running tasks are finished.
+     *
+     *  No new executions are dispatched after the call. Executions which were already dispatched to a
+     *  workstation are still executed, and the call returns after the last of them has finished.
+     *  It must not be called from a task function.
+     */
+    void stop();
+
+    /** Get the metrics of all tasks.
+     *
+     * \return The metrics.
+     */
+    std::vector<TaskMetrics> getMetrics() const;
+
+private:
+    class ScheduledTask
+    {
+    public:
+        Task task;
+        TaskMetrics metrics;
+        uint64_t nextTick = 0;
+        bool pending = false;
+    };
+
+    class Dispatch
+    {
+    public:
+        uint64_t id;
+        std::chrono::steady_clock::time_point scheduledTime;
+    };
+
+    class Workstation
+    {
+    public:
+        ThalesRemoteScriptWrapper* wrapper;
+        std::deque<Dispatch> dispatches;
+        bool executing = false;
+        std::condition_variable dispatchAvailable;
+        std::thread *worker = nullptr;
+    };
+
+    /** Function which is executed as scheduler thread. */
+    void schedulerJob();
+
+    /** Function which is executed as worker thread for each workstation. */
+    void workstationJob(Workstation* workstation);
+
+    /** Convert a tick to a time point. */
+    std::chrono::steady_clock::time_point tickToTime(uint64_t tick) const;
+
+    /** Convert a duration to the number of ticks, rounded up. */
+    uint64_t durationToTicks(std::chrono::milliseconds duration) const;
+
+    const std::chrono::milliseconds tick;
+    std::chrono::steady_clock::time_point startTime;
+
+    mutable std::mutex mutex;
+    std::condition_variable stateChanged;
+    std::condition_variable workstationsIdle;
+    TimingWheel wheel;
+    std::unordered_map<uint64_t, ScheduledTask> tasks;
+    std::vector<std::unique_ptr<Workstation>> workstations;
+    uint64_t nextId;
+    bool scheduler_is_running;
+    bool workers_are_running;
+
+    std::thread *schedulerWorker;
+};
+
+#endif // MONITORINGSCHEDULER_H
@@ -0,0 +1,173 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "pad4impedance.h"
+#include <charconv>
+#include <cmath>
+
+static const char* skipSpaces(const char* position, const char* end)
+{
+    while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+    {
+        position++;
+    }
+    return position;
+}
+
+static const char* parseDouble(const char* position, const char* end, double& value)
+{
+    position = skipSpaces(position, end);
+    if (position < end && *position == '+')
+    {
+        position++;
+    }
+    auto result = std::from_chars(position, end, value);
+    if (result.ec != std::errc())
+    {
+        value = std::nan("1");
+        return position;
+    }
+    return result.ptr;
+}
+
+static int channelIndexFromLabel(std::string_view label)
+{
+    while (label.empty() == false && label.front() == ' ')
+    {
+        label.remove_prefix(1);
+    }
+    while (label.empty() == false && label.back() == ' ')
+    {
+        label.remove_suffix(1);
+    }
+
+    if (label == "impedance")
+    {
+        return 0;
+    }
+
+    if (label.size() > 3 && label.substr(0, 3) == "pad")
+    {
+        int index = -1;
+        auto result = std::from_chars(label.data() + 3, label.data() + label.size(), index);
+        if (result.ec == std::errc() && index >= 1 && index <= Pad4Impedance::numberOfPadChannels)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+Pad4Impedance::Pad4Impedance() :
+    enabledMask(0)
+{
+    this->impedances.fill(std::complex<double>(std::nan("1"), std::nan("1")));
+}
+
+Pad4Impedance Pad4Impedance::fromReply(std::string_view reply)
+{
+    Pad4Impedance retval;
+
+    const char* position = reply.data();
+    const char* end = reply.data() + reply.size();
+
+    while (position < end)
+    {
+        const char* labelBegin = position;
+        while (position < end && *position != '=' && *position != ';')
+        {
+            position++;
+        }
+
+        if (position < end && *position == '=')
+        {
+            int index = channelIndexFromLabel(std::string_view(labelBegin, position - labelBegin));
+            double real;
+            double imag;
+
+            position = parseDouble(position + 1, end, real);
+            position = skipSpaces(position, end);
+            if (position < end && *position == ',')
+            {
+                position++;
+            }
+            position = parseDouble(position, end, imag);
+
+            if (index >= 0)
+            {
+                retval.impedances[index] = std::complex<double>(real, imag);
+                if (real != 0.0 || imag != 0.0)
+                {
+                    retval.enabledMask |= (1u << index);
+                }
+            }
+        }
+
+        while (position < end && *position != ';')
+        {
+            position++;
+        }
+        if (position < end)
+        {
+            position++;
+        }
+    }
+
+    return retval;
+}
+
+std::complex<double> Pad4Impedance::getMainImpedance() const
+{
+    return this->impedances[0];
+}
+
+std::complex<double> Pad4Impedance::getPadImpedance(int pad) const
+{
+    if (pad < 1 || pad > numberOfPadChannels)
+    {
+        return std::complex<double>(std::nan("1"), std::nan("1"));
+    }
+    return this->impedances[pad];
+}
+
+bool Pad4Impedance::isChannelEnabled(int channel) const
+{
+    if (channel < 0 || channel >= numberOfChannels)
+    {
+        return false;
+    }
+    return (this->enabledMask & (1u << channel)) != 0;
+}
+
+uint32_t Pad4Impedance::getEnabledMask() const
+{
+    return this->enabledMask;
+}
+
+const std::array<std::complex<double>, Pad4Impedance::numberOfChannels>& Pad4Impedance::getImpedances() const
+{
+    return this->impedances;
+}
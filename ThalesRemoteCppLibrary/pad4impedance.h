@@ -0,0 +1,107 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PAD4IMPEDANCE_H
+#define PAD4IMPEDANCE_H
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <string_view>
+
+/** The Pad4Impedance class
+ *
+ *  Typed result of a PAD4 impedance measurement.
+ *
+ *  Thales returns the result of ThalesRemoteScriptWrapper::getImpedancePad4 as a string like
+ *  "impedance= -1.640e-02, 8.926e-03;pad01= -1.745e-01,-1.380e-01;...;pad16=  0.000e+00, 0.000e+00".
+ *  This class holds the main channel and the 16 PAD4 channels in a fixed array, so no heap memory
+ *  is required to parse or to store a measurement point.
+ *
+ *  Index 0 is the main channel, indices 1 to 16 are the PAD4 channels pad01 to pad16.
+ *  Channels which are deactivated are reported by Thales with the value 0. They are not marked
+ *  in the enabled mask.
+ */
+class Pad4Impedance
+{
+public:
+    static constexpr int numberOfPadChannels = 16;
+    static constexpr int numberOfChannels = numberOfPadChannels + 1;
+
+    Pad4Impedance();
+
+    /** Parse the reply of the PAD4IMP command in a single pass.
+     *
+     *  The parser does not allocate memory. Unknown labels are ignored.
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The parsed impedance result.
+     */
+    static Pad4Impedance fromReply(std::string_view reply);
+
+    /** Get the impedance of the main channel.
+     *
+     * \return The complex impedance of the main channel.
+     */
+    std::complex<double> getMainImpedance() const;
+
+    /** Get the impedance of a PAD4 channel.
+     *
+     * \param  pad The PAD4 channel from 1 to 16.
+     *
+     * \return The complex impedance of the channel or NaN if the index is out of range.
+     */
+    std::complex<double> getPadImpedance(int pad) const;
+
+    /** Check if a channel delivered a value.
+     *
+     * \param  channel The channel index, 0 for the main channel and 1 to 16 for the PAD4 channels.
+     *
+     * \return true if the channel is enabled.
+     */
+    bool isChannelEnabled(int channel) const;
+
+    /** Get the enabled mask.
+     *
+     *  Bit 0 is the main channel, bit 1 to 16 are the PAD4 channels.
+     *
+     * \return The enabled mask.
+     */
+    uint32_t getEnabledMask() const;
+
+    /** Get all channels.
+     *
+     * \return Array with the main channel at index 0 and the PAD4 channels at 1 to 16.
+     */
+    const std::array<std::complex<double>, numberOfChannels>& getImpedances() const;
+
+private:
+    std::array<std::complex<double>, numberOfChannels> impedances;
+    uint32_t enabledMask;
+};
+
+#endif // PAD4IMPEDANCE_H
@@ -0,0 +1,211 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PARAMETERDESCRIPTOR_H
+#define PARAMETERDESCRIPTOR_H
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "parameterrangeerror.h"
+#include "remoteparameters.h"
+
+/** The ParameterDescriptor class
+ *
+ *  Compile-time description of a Remote2 parameter.
+ *
+ *  A descriptor carries the device key, the value type, the unit and the valid range of a parameter.
+ *  The typed setters of the ThalesRemoteScriptWrapper check the value against the descriptor before
+ *  anything is sent, so an invalid value costs no round trip and is reported with a ParameterRangeError.
+ *
+ *  The limits are inclusive. NaN is never valid.
+ */
+template <typename T>
+class ParameterDescriptor
+{
+public:
+    std::string_view key;   /**< Name of the Remote2 parameter. */
+    std::string_view unit;  /**< Unit of the value, empty if the value has no unit. */
+    T minimum;              /**< Smallest valid value. */
+    T maximum;              /**< Largest valid value. */
+
+    /** Check if a value is inside the valid range.
+     *
+     * \param  value The value to check.
+     *
+     * \return true if the value is valid.
+     */
+    constexpr bool isValid(T value) const
+    {
+        return value >= this->minimum && value <= this->maximum;
+    }
+
+    /** Throw a ParameterRangeError if the value is outside the valid range.
+     *
+     * \param  value The value to check.
+     * \param  name Name of the value for the error message, the key is used if empty.
+     */
+    void check(T value, std::string_view name = {}) const
+    {
+        if (this->isValid(value) == false)
+        {
+            std::stringstream message;
+            message << (name.empty() ? this->key : name) << "=" << value;
+            if (this->unit.empty() == false)
+            {
+                message << " " << this->unit;
+            }
+            message << " is outside the valid range [" << this->minimum << ", " << this->maximum << "].";
+            throw ParameterRangeError(message.str());
+        }
+    }
+};
+
+/** Descriptors of the Remote2 parameters used by the ThalesRemoteScriptWrapper.
+ *
+ *  The ranges only reject values which are invalid for every device.
+ *  Device specific limits, for example the maximum current, are still checked by Thales.
+ */
+namespace Parameters {
+
+constexpr double unbounded = std::numeric_limits<double>::max();
+constexpr double smallestPositive = std::numeric_limits<double>::min();
+constexpr int maximumIndex = std::numeric_limits<int>::max();
+
+// The frequency range depends on the device, only non-positive frequencies are invalid for all of them.
+constexpr double minimumFrequency = smallestPositive;
+constexpr double maximumFrequency = unbounded;
+
+/*
+ * Potentiostat and general settings
+ */
+constexpr ParameterDescriptor<double> Current{RemoteParameter::Cset, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> Potential{RemoteParameter::Pset, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<int> MaximumShuntIndex{RemoteParameter::Rmax, "", 0, maximumIndex};
+constexpr ParameterDescriptor<int> MinimumShuntIndex{RemoteParameter::Rmin, "", 0, maximumIndex};
+constexpr ParameterDescriptor<int> VoltageRangeIndex{RemoteParameter::Potrange, "", 0, maximumIndex};
+constexpr ParameterDescriptor<int> Potentiostat{RemoteParameter::DEV, "", 0, maximumIndex};
+constexpr ParameterDescriptor<int> PotentiostatWithoutStateChange{RemoteParameter::DEVHOT, "", 0, maximumIndex};
+
+/*
+ * PAD4
+ */
+constexpr ParameterDescriptor<int> Pad4Card{RemoteParameter::PAD4, "", 1, 4};
+constexpr ParameterDescriptor<int> Pad4Channel{RemoteParameter::PAD4, "", 1, 4};
+constexpr ParameterDescriptor<double> Pad4VoltageRange{RemoteParameter::PAD4_PRANGE, "V", smallestPositive, unbounded};
+constexpr ParameterDescriptor<double> Pad4ShuntResistor{RemoteParameter::PAD4_RSHUNT, "Ohm", smallestPositive, unbounded};
+
+/*
+ * Single impedance and EIS
+ */
+constexpr ParameterDescriptor<double> Frequency{RemoteParameter::Frq, "Hz", minimumFrequency, maximumFrequency};
+constexpr ParameterDescriptor<double> Amplitude{RemoteParameter::Ampl, "V or A", 0.0, unbounded};
+constexpr ParameterDescriptor<int> NumberOfPeriods{RemoteParameter::Nw, "", 1, maximumIndex};
+constexpr ParameterDescriptor<double> UpperFrequencyLimit{RemoteParameter::Fmax, "Hz", minimumFrequency, maximumFrequency};
+constexpr ParameterDescriptor<double> LowerFrequencyLimit{RemoteParameter::Fmin, "Hz", minimumFrequency, maximumFrequency};
+constexpr ParameterDescriptor<double> StartFrequency{RemoteParameter::Fstart, "Hz", minimumFrequency, maximumFrequency};
+constexpr ParameterDescriptor<int> UpperStepsPerDecade{RemoteParameter::dfm, "", 1, maximumIndex};
+constexpr ParameterDescriptor<int> LowerStepsPerDecade{RemoteParameter::dfl, "", 1, maximumIndex};
+constexpr ParameterDescriptor<int> UpperNumberOfPeriods{RemoteParameter::Nws, "", 1, maximumIndex};
+constexpr ParameterDescriptor<int> LowerNumberOfPeriods{RemoteParameter::Nwl, "", 1, maximumIndex};
+constexpr ParameterDescriptor<int> EISCounter{RemoteParameter::EIS_NUM, "", 0, maximumIndex};
+
+/*
+ * CV
+ */
+constexpr ParameterDescriptor<double> CVStartPotential{RemoteParameter::CV_Pstart, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVUpperReversingPotential{RemoteParameter::CV_Pupper, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVLowerReversingPotential{RemoteParameter::CV_Plower, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVEndPotential{RemoteParameter::CV_Pend, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVStartHoldTime{RemoteParameter::CV_Tstart, "s", 0.0, unbounded};
+constexpr ParameterDescriptor<double> CVEndHoldTime{RemoteParameter::CV_Tend, "s", 0.0, unbounded};
+constexpr ParameterDescriptor<double> CVScanRate{RemoteParameter::CV_Srate, "V/s", smallestPositive, unbounded};
+constexpr ParameterDescriptor<double> CVCycles{RemoteParameter::CV_Periods, "", 0.5, unbounded};
+constexpr ParameterDescriptor<double> CVSamplesPerCycle{RemoteParameter::CV_PpPer, "", 1.0, unbounded};
+constexpr ParameterDescriptor<double> CVMaximumCurrent{RemoteParameter::CV_Ima, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVMinimumCurrent{RemoteParameter::CV_Imi, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> CVOhmicDrop{RemoteParameter::CV_Odrop, "Ohm", 0.0, unbounded};
+constexpr ParameterDescriptor<int> CVCounter{RemoteParameter::CV_NUM, "", 0, maximumIndex};
+
+/*
+ * IE
+ */
+constexpr ParameterDescriptor<double> IEFirstEdgePotential{RemoteParameter::IE_EckPot1, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> IESecondEdgePotential{RemoteParameter::IE_EckPot2, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> IEThirdEdgePotential{RemoteParameter::IE_EckPot3, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> IEFourthEdgePotential{RemoteParameter::IE_EckPot4, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> IEPotentialResolution{RemoteParameter::IE_Resolution, "V", smallestPositive, unbounded};
+constexpr ParameterDescriptor<double> IEMinimumWaitingTime{RemoteParameter::IE_WZmin, "s", 0.0, unbounded};
+constexpr ParameterDescriptor<double> IEMaximumWaitingTime{RemoteParameter::IE_WZmax, "s", 0.0, unbounded};
+constexpr ParameterDescriptor<double> IERelativeTolerance{RemoteParameter::IE_Torel, "", 0.0, unbounded};
+constexpr ParameterDescriptor<double> IEAbsoluteTolerance{RemoteParameter::IE_Toabs, "A", 0.0, unbounded};
+constexpr ParameterDescriptor<double> IEOhmicDrop{RemoteParameter::IE_Odrop, "Ohm", 0.0, unbounded};
+constexpr ParameterDescriptor<double> IEScanRate{RemoteParameter::IE_Srate, "V/s", smallestPositive, unbounded};
+constexpr ParameterDescriptor<double> IEMaximumCurrent{RemoteParameter::IE_Ima, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> IEMinimumCurrent{RemoteParameter::IE_Imi, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<int> IECounter{RemoteParameter::IE_NUM, "", 0, maximumIndex};
+
+/*
+ * Sequencer
+ */
+constexpr ParameterDescriptor<int> Sequence{RemoteParameter::SELSEQ, "", 0, 9};
+constexpr ParameterDescriptor<int> SequenceCounter{RemoteParameter::SEQ_NUM, "", 0, maximumIndex};
+constexpr ParameterDescriptor<int> SequenceAcqChannel{RemoteParameter::SEQ_ACQ, "", 0, maximumIndex};
+constexpr ParameterDescriptor<double> SequenceOhmicDrop{RemoteParameter::SEQ_RODROP, "Ohm", 0.0, unbounded};
+constexpr ParameterDescriptor<double> SequenceMaximumRuntime{RemoteParameter::SEQ_MAXTIME, "h", 0.0, unbounded};
+constexpr ParameterDescriptor<double> SequenceUpperPotentialLimit{RemoteParameter::SEQ_EUPPER, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> SequenceLowerPotentialLimit{RemoteParameter::SEQ_ELOWER, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> SequenceUpperCurrentLimit{RemoteParameter::SEQ_IUPPER, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> SequenceLowerCurrentLimit{RemoteParameter::SEQ_ILOWER, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> SequenceCurrentRange{RemoteParameter::SEQ_IRANGE, "A", 0.0, unbounded};
+constexpr ParameterDescriptor<double> SequencePotentialLatencyWindow{RemoteParameter::SEQ_POTOFLO, "s", 0.0, unbounded};
+constexpr ParameterDescriptor<double> SequenceCurrentLatencyWindow{RemoteParameter::SEQ_CUROFLO, "s", 0.0, unbounded};
+
+/*
+ * FRA
+ */
+constexpr ParameterDescriptor<double> FraVoltageInputGain{RemoteParameter::FRA_POT_IN, "", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraVoltageInputOffset{RemoteParameter::FRA_POT_IN_OFF, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraVoltageOutputGain{RemoteParameter::FRA_POT_OUT, "", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraVoltageOutputOffset{RemoteParameter::FRA_POT_OUT_OFF, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraVoltageMinimum{RemoteParameter::FRA_POT_MIN, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraVoltageMaximum{RemoteParameter::FRA_POT_MAX, "V", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentInputGain{RemoteParameter::FRA_CUR_IN, "", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentInputOffset{RemoteParameter::FRA_CUR_IN_OFF, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentOutputGain{RemoteParameter::FRA_CUR_OUT, "", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentOutputOffset{RemoteParameter::FRA_CUR_OUT_OFF, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentMinimum{RemoteParameter::FRA_CUR_MIN, "A", -unbounded, unbounded};
+constexpr ParameterDescriptor<double> FraCurrentMaximum{RemoteParameter::FRA_CUR_MAX, "A", -unbounded, unbounded};
+
+/*
+ * ACQ
+ */
+constexpr ParameterDescriptor<int> AcqChannel{RemoteParameter::CHANNEL, "", 0, maximumIndex};
+
+} // namespace Parameters
+
+#endif // PARAMETERDESCRIPTOR_H
@@ -0,0 +1,88 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "receivedfileindex.h"
+#include <sstream>
+#include "zahnererror.h"
+
+ReceivedFileIndex::ReceivedFileIndex(std::filesystem::path path)
+{
+    if (path.empty() == true)
+    {
+        return;
+    }
+
+    std::ifstream existing(path);
+    std::string line;
+    while (std::getline(existing, line))
+    {
+        std::istringstream fields(line);
+        std::string hash;
+        Entry entry;
+        if (fields >> hash >> entry.size)
+        {
+            std::getline(fields >> std::ws, entry.name);
+            this->entries.emplace(hash, entry);
+        }
+    }
+    existing.close();
+
+    this->file.open(path, std::ofstream::app);
+    if (this->file.is_open() == false)
+    {
+        throw ZahnerError("The index file " + path.string() + " could not be opened.");
+    }
+}
+
+bool ReceivedFileIndex::find(const std::string& hash, Entry& entry) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->entries.find(hash);
+    if (found == this->entries.end())
+    {
+        return false;
+    }
+    entry = found->second;
+    return true;
+}
+
+bool ReceivedFileIndex::insert(const std::string& hash, size_t size, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto [position, inserted] = this->entries.emplace(hash, Entry{size, name});
+    if (inserted == true && this->file.is_open() == true)
+    {
+        this->file << hash << ' ' << size << ' ' << name << '\n';
+        this->file.flush();
+    }
+    return inserted;
+}
+
+size_t ReceivedFileIndex::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->entries.size();
+}
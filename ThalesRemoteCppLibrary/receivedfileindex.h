@@ -0,0 +1,95 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RECEIVEDFILEINDEX_H
+#define RECEIVEDFILEINDEX_H
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/** The ReceivedFileIndex class
+ *
+ *  Persistent index of the content hashes of received files.
+ *
+ *  Each entry maps the SHA-256 of the content to the size and the name under which the content was stored
+ *  first. The index is kept in memory and every new entry is appended as a line "hash size name" to the
+ *  index file, so it survives a restart and identical content is stored only once across sessions.
+ */
+class ReceivedFileIndex
+{
+public:
+    class Entry
+    {
+    public:
+        size_t size = 0;    /**< Size of the content in bytes. */
+        std::string name;   /**< Name of the first file with this content. */
+    };
+
+    /** Constructor. An existing index file is loaded.
+     *
+     * \param  path The path of the index file, empty for an index which is only kept in memory.
+     */
+    ReceivedFileIndex(std::filesystem::path path = {});
+
+    ReceivedFileIndex(const ReceivedFileIndex &) = delete;
+    ReceivedFileIndex& operator=(const ReceivedFileIndex &) = delete;
+
+    /** Find the entry of a hash.
+     *
+     * \param  hash The hexadecimal SHA-256.
+     * \param  entry Receives the entry if found.
+     *
+     * \return true if the content is already known.
+     */
+    bool find(const std::string& hash, Entry& entry) const;
+
+    /** Add a hash if it is not known yet.
+     *
+     * \param  hash The hexadecimal SHA-256.
+     * \param  size Size of the content in bytes.
+     * \param  name Name of the file.
+     *
+     * \return false if the hash was already in the index.
+     */
+    bool insert(const std::string& hash, size_t size, const std::string& name);
+
+    /** Get the number of entries.
+     *
+     * \return The number of entries.
+     */
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::ofstream file;
+};
+
+#endif // RECEIVEDFILEINDEX_H
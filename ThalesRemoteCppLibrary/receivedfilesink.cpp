@@ -0,0 +1,122 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "receivedfilesink.h"
+#include "zahnererror.h"
+
+DiskFileSink::DiskFileSink(std::filesystem::path directory) :
+    directory(std::move(directory))
+{
+
+}
+
+void DiskFileSink::begin(const std::string& name, const std::string& path, size_t length)
+{
+    (void)path;
+
+    /*
+     * The data is written to a temporary file which replaces the destination only if the file is complete,
+     * so a dropped file does not destroy an existing file with the same name.
+     */
+    this->currentFile = this->directory / std::filesystem::path(name);
+    this->temporaryFile = this->currentFile;
+    this->temporaryFile += ".part";
+    this->written = 0;
+    this->stream.open(this->temporaryFile, std::ofstream::binary | std::ofstream::trunc);
+    if (this->stream.is_open() == false)
+    {
+        throw ZahnerError("The file " + this->temporaryFile.string() + " could not be opened.");
+    }
+
+    /*
+     * Preallocation from the announced length. The stream stays at the beginning and overwrites the space.
+     */
+    if (length > 0)
+    {
+        std::error_code error;
+        std::filesystem::resize_file(this->temporaryFile, length, error);
+    }
+}
+
+void DiskFileSink::write(const uint8_t* data, size_t size)
+{
+    this->stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    this->written += size;
+}
+
+void DiskFileSink::end(bool complete)
+{
+    std::error_code error;
+    this->stream.close();
+    if (complete == false || this->stream.fail() == true)
+    {
+        std::filesystem::remove(this->temporaryFile, error);
+        this->stream.clear();
+        return;
+    }
+    this->stream.clear();
+
+    if (std::filesystem::file_size(this->temporaryFile, error) != this->written)
+    {
+        std::filesystem::resize_file(this->temporaryFile, this->written, error);
+    }
+    std::filesystem::rename(this->temporaryFile, this->currentFile, error);
+    if (error)
+    {
+        std::filesystem::remove(this->temporaryFile, error);
+        throw ZahnerError("The file " + this->currentFile.string() + " could not be written.");
+    }
+}
+
+CallbackFileSink::CallbackFileSink(ChunkCallback chunkCallback, FinishedCallback finishedCallback) :
+    chunkCallback(std::move(chunkCallback)),
+    finishedCallback(std::move(finishedCallback))
+{
+
+}
+
+void CallbackFileSink::begin(const std::string& name, const std::string& path, size_t length)
+{
+    (void)path;
+    (void)length;
+    this->currentName = name;
+}
+
+void CallbackFileSink::write(const uint8_t* data, size_t size)
+{
+    if (this->chunkCallback)
+    {
+        this->chunkCallback(this->currentName, data, size);
+    }
+}
+
+void CallbackFileSink::end(bool complete)
+{
+    if (this->finishedCallback)
+    {
+        this->finishedCallback(this->currentName, complete);
+    }
+}
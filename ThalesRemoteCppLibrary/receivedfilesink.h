@@ -0,0 +1,127 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RECEIVEDFILESINK_H
+#define RECEIVEDFILESINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+/** The ReceivedFileSink class
+ *
+ *  Destination for a file which is received in streaming mode by the ThalesFileInterface.
+ *
+ *  The data of the file arrives in chunks. Each chunk is passed to write as soon as it is received, so the
+ *  memory required for a transfer is one chunk instead of the whole file.
+ */
+class ReceivedFileSink
+{
+public:
+    virtual ~ReceivedFileSink() = default;
+
+    /** Called before the first chunk of a file.
+     *
+     * \param  name Filename without path.
+     * \param  path Filename with path on the Thales computer.
+     * \param  length Length of the file in bytes as announced by Term.
+     */
+    virtual void begin(const std::string& name, const std::string& path, size_t length) = 0;
+
+    /** Called for each chunk of the file.
+     *
+     * \param  data Pointer to the chunk.
+     * \param  size Size of the chunk in bytes.
+     */
+    virtual void write(const uint8_t* data, size_t size) = 0;
+
+    /** Called after the last chunk or when the transfer was interrupted.
+     *
+     * \param  complete false if the transfer was interrupted.
+     */
+    virtual void end(bool complete) = 0;
+};
+
+/** The DiskFileSink class
+ *
+ *  Writes the received files directly into a directory on the local computer.
+ *
+ *  The file is extended to the length announced by Term before the first chunk is written, so the file
+ *  system can reserve the space at once. The data is written to "<name>.part", which is renamed when the file
+ *  is complete. Incomplete and dropped files are deleted.
+ */
+class DiskFileSink : public ReceivedFileSink
+{
+public:
+    /** Constructor.
+     *
+     * \param  directory The directory, which must exist.
+     */
+    DiskFileSink(std::filesystem::path directory);
+
+    void begin(const std::string& name, const std::string& path, size_t length) override;
+    void write(const uint8_t* data, size_t size) override;
+    void end(bool complete) override;
+
+private:
+    std::filesystem::path directory;
+    std::filesystem::path currentFile;
+    std::filesystem::path temporaryFile;
+    std::ofstream stream;
+    size_t written = 0;
+};
+
+/** The CallbackFileSink class
+ *
+ *  Passes the chunks of the received files to functions.
+ */
+class CallbackFileSink : public ReceivedFileSink
+{
+public:
+    typedef std::function<void(const std::string& name, const uint8_t* data, size_t size)> ChunkCallback;
+    typedef std::function<void(const std::string& name, bool complete)> FinishedCallback;
+
+    /** Constructor.
+     *
+     * \param  chunkCallback Function which is called with each chunk.
+     * \param  finishedCallback Optional function which is called at the end of each file.
+     */
+    CallbackFileSink(ChunkCallback chunkCallback, FinishedCallback finishedCallback = nullptr);
+
+    void begin(const std::string& name, const std::string& path, size_t length) override;
+    void write(const uint8_t* data, size_t size) override;
+    void end(bool complete) override;
+
+private:
+    ChunkCallback chunkCallback;
+    FinishedCallback finishedCallback;
+    std::string currentName;
+};
+
+#endif // RECEIVEDFILESINK_H
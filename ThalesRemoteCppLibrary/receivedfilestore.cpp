@@ -0,0 +1,215 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "receivedfilestore.h"
+#include <algorithm>
+
+ReceivedFileStore::ReceivedFileStore(size_t maximumFiles, size_t maximumBytes, EvictionPolicy policy) :
+    maximumFiles(maximumFiles),
+    maximumBytes(maximumBytes),
+    policy(policy),
+    nextSequence(0),
+    bytes(0),
+    evictedFiles(0)
+{
+
+}
+
+void ReceivedFileStore::setLimits(size_t maximumFiles, size_t maximumBytes)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maximumFiles = maximumFiles;
+    this->maximumBytes = maximumBytes;
+    this->evict();
+}
+
+void ReceivedFileStore::setEvictionPolicy(EvictionPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->policy = policy;
+}
+
+ReceivedFileStore::FilePointer ReceivedFileStore::put(ThalesFileInterface::FileObject&& file)
+{
+    return this->put(std::make_shared<const ThalesFileInterface::FileObject>(std::move(file)));
+}
+
+ReceivedFileStore::FilePointer ReceivedFileStore::put(FilePointer pointer)
+{
+    if (pointer == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->entries.push_back(Entry{pointer, this->nextSequence++});
+    this->byName[pointer->name] = std::prev(this->entries.end());
+    this->bytes += pointer->binary_data.size();
+    this->latest = pointer;
+    this->evict();
+    return pointer;
+}
+
+ReceivedFileStore::FilePointer ReceivedFileStore::get(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->byName.find(name);
+    if (found == this->byName.end())
+    {
+        return nullptr;
+    }
+    this->touch(found->second);
+    return found->second->file;
+}
+
+ReceivedFileStore::FilePointer ReceivedFileStore::getLatest()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->latest == nullptr)
+    {
+        return nullptr;
+    }
+    auto found = this->byName.find(this->latest->name);
+    if (found != this->byName.end() && found->second->file == this->latest)
+    {
+        this->touch(found->second);
+    }
+    return this->latest;
+}
+
+std::vector<ReceivedFileStore::FilePointer> ReceivedFileStore::snapshot() const
+{
+    std::vector<const Entry*> ordered;
+    std::vector<FilePointer> retval;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ordered.reserve(this->entries.size());
+        for (const auto& entry : this->entries)
+        {
+            ordered.push_back(&entry);
+        }
+
+        /*
+         * With LRU the list is in usage order, the snapshot is always in the order of arrival.
+         */
+        std::sort(ordered.begin(), ordered.end(), [](const Entry* a, const Entry* b) {
+            return a->sequence < b->sequence;
+        });
+
+        retval.reserve(ordered.size());
+        for (const auto* entry : ordered)
+        {
+            retval.push_back(entry->file);
+        }
+    }
+    return retval;
+}
+
+ReceivedFileStore::FilePointer ReceivedFileStore::take(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->byName.find(name);
+    if (found == this->byName.end())
+    {
+        return nullptr;
+    }
+    FilePointer retval = found->second->file;
+    this->erase(found->second);
+    return retval;
+}
+
+std::vector<ReceivedFileStore::FilePointer> ReceivedFileStore::takeAll()
+{
+    std::vector<FilePointer> retval = this->snapshot();
+    this->clear();
+    return retval;
+}
+
+void ReceivedFileStore::clear()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->entries.clear();
+    this->byName.clear();
+    this->latest = nullptr;
+    this->bytes = 0;
+}
+
+size_t ReceivedFileStore::getNumberOfFiles() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->entries.size();
+}
+
+size_t ReceivedFileStore::getNumberOfBytes() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->bytes;
+}
+
+unsigned long ReceivedFileStore::getEvictedFiles() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->evictedFiles;
+}
+
+void ReceivedFileStore::evict()
+{
+    while (this->entries.size() > 1 &&
+           ((this->maximumFiles > 0 && this->entries.size() > this->maximumFiles) ||
+            (this->maximumBytes > 0 && this->bytes > this->maximumBytes)))
+    {
+        this->erase(this->entries.begin());
+        this->evictedFiles++;
+    }
+}
+
+void ReceivedFileStore::erase(Position position)
+{
+    auto found = this->byName.find(position->file->name);
+    if (found != this->byName.end() && found->second == position)
+    {
+        this->byName.erase(found);
+    }
+    const bool wasLatest = this->latest == position->file;
+    this->bytes -= position->file->binary_data.size();
+    this->entries.erase(position);
+
+    if (wasLatest == true)
+    {
+        auto newest = std::max_element(this->entries.begin(), this->entries.end(), [](const Entry& a, const Entry& b) {
+            return a.sequence < b.sequence;
+        });
+        this->latest = newest != this->entries.end() ? newest->file : nullptr;
+    }
+}
+
+void ReceivedFileStore::touch(Position position)
+{
+    if (this->policy == EvictionPolicy::LRU)
+    {
+        this->entries.splice(this->entries.end(), this->entries, position);
+    }
+}
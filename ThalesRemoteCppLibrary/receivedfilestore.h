@@ -0,0 +1,190 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RECEIVEDFILESTORE_H
+#define RECEIVEDFILESTORE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "thalesfileinterface.h"
+
+/** The ReceivedFileStore class
+ *
+ *  Thread-safe store for received files with a limit for the number of files and the number of bytes.
+ *
+ *  The files are moved into the store and kept as shared immutable objects. Readers receive shared pointers,
+ *  so a snapshot of the store copies only pointers and never the data, and a file remains valid for a reader
+ *  even if it is evicted from the store in the meantime.
+ *
+ *  If a limit is exceeded, files are evicted. With FIFO the oldest received file is evicted, with LRU the file
+ *  which was accessed least recently with get or getLatest.
+ */
+class ReceivedFileStore
+{
+public:
+    typedef std::shared_ptr<const ThalesFileInterface::FileObject> FilePointer;
+
+    enum class EvictionPolicy
+    {
+        FIFO,
+        LRU
+    };
+
+    /** Constructor.
+     *
+     * \param  maximumFiles The maximum number of files, 0 for no limit.
+     * \param  maximumBytes The maximum number of bytes of all files, 0 for no limit.
+     * \param  policy The eviction policy.
+     */
+    ReceivedFileStore(size_t maximumFiles = 0, size_t maximumBytes = 0, EvictionPolicy policy = EvictionPolicy::FIFO);
+
+    ReceivedFileStore(const ReceivedFileStore &) = delete;
+    ReceivedFileStore& operator=(const ReceivedFileStore &) = delete;
+
+    /** Set the limits. Files are evicted immediately if necessary.
+     *
+     * \param  maximumFiles The maximum number of files, 0 for no limit.
+     * \param  maximumBytes The maximum number of bytes of all files, 0 for no limit.
+     */
+    void setLimits(size_t maximumFiles, size_t maximumBytes);
+
+    /** Set the eviction policy.
+     *
+     * \param  policy The eviction policy.
+     */
+    void setEvictionPolicy(EvictionPolicy policy);
+
+    /** Move a file into the store.
+     *
+     *  A single file which is larger than the byte limit is stored alone.
+     *
+     * \param  file The file.
+     *
+     * \return Pointer to the stored file.
+     */
+    FilePointer put(ThalesFileInterface::FileObject&& file);
+
+    /** Add an already shared file to the store.
+     *
+     * \param  file Pointer to the file.
+     *
+     * \return Pointer to the stored file.
+     */
+    FilePointer put(FilePointer file);
+
+    /** Get the most recently received file with a name.
+     *
+     * \param  name Filename without path.
+     *
+     * \return Pointer to the file or nullptr.
+     */
+    FilePointer get(const std::string& name);
+
+    /** Get the most recently received file.
+     *
+     * \return Pointer to the file or nullptr if the store is empty.
+     */
+    FilePointer getLatest();
+
+    /** Get all files in the order of arrival without copying their data.
+     *
+     * \return Pointers to the files.
+     */
+    std::vector<FilePointer> snapshot() const;
+
+    /** Remove the most recently received file with a name from the store.
+     *
+     * \param  name Filename without path.
+     *
+     * \return Pointer to the file or nullptr.
+     */
+    FilePointer take(const std::string& name);
+
+    /** Remove all files from the store.
+     *
+     * \return Pointers to the files in the order of arrival.
+     */
+    std::vector<FilePointer> takeAll();
+
+    /** Delete all files. */
+    void clear();
+
+    /** Get the number of stored files.
+     *
+     * \return The number of files.
+     */
+    size_t getNumberOfFiles() const;
+
+    /** Get the number of bytes of all stored files.
+     *
+     * \return The number of bytes.
+     */
+    size_t getNumberOfBytes() const;
+
+    /** Get the number of files which were evicted because of the limits.
+     *
+     * \return The number of evicted files.
+     */
+    unsigned long getEvictedFiles() const;
+
+private:
+    class Entry
+    {
+    public:
+        FilePointer file;
+        unsigned long long sequence;    /**< Order of arrival. */
+    };
+
+    typedef std::list<Entry>::iterator Position;
+
+    /** Evict files until the limits are kept. Requires the lock. */
+    void evict();
+
+    /** Remove an entry. Requires the lock. */
+    void erase(Position position);
+
+    /** Move an entry to the end of the usage order if the policy is LRU. Requires the lock. */
+    void touch(Position position);
+
+    mutable std::mutex mutex;
+    size_t maximumFiles;
+    size_t maximumBytes;
+    EvictionPolicy policy;
+
+    std::list<Entry> entries;           /**< Eviction order, the front is evicted first. */
+    std::unordered_map<std::string, Position> byName;
+    FilePointer latest;
+    unsigned long long nextSequence;
+    size_t bytes;
+    unsigned long evictedFiles;
+};
+
+#endif // RECEIVEDFILESTORE_H
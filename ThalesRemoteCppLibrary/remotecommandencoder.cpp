@@ -0,0 +1,103 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "remotecommandencoder.h"
+#include <charconv>
+#include "thalesremoteerror.h"
+
+/** Precision of the floating point values which are sent to Thales. */
+static constexpr int doublePrecision = 10;
+
+RemoteCommandEncoder::RemoteCommandEncoder() :
+    length(0)
+{
+
+}
+
+std::string_view RemoteCommandEncoder::encodeCommand(std::string_view command)
+{
+    this->begin();
+    this->append(command);
+    return this->end();
+}
+
+void RemoteCommandEncoder::begin()
+{
+    this->length = 0;
+    this->append("1:");
+}
+
+std::string_view RemoteCommandEncoder::end()
+{
+    this->append(":");
+    return std::string_view(this->buffer.data(), this->length);
+}
+
+void RemoteCommandEncoder::append(std::string_view text)
+{
+    if (this->length + text.size() > this->buffer.size())
+    {
+        throw ThalesRemoteError("Remote command is too long.");
+    }
+    std::copy(text.begin(), text.end(), this->buffer.begin() + this->length);
+    this->length += text.size();
+}
+
+void RemoteCommandEncoder::appendValue(double value)
+{
+    auto result = std::to_chars(this->buffer.data() + this->length, this->buffer.data() + this->buffer.size(),
+                                value, std::chars_format::scientific, doublePrecision);
+    if (result.ec != std::errc())
+    {
+        throw ThalesRemoteError("Remote command is too long.");
+    }
+    this->length = static_cast<size_t>(result.ptr - this->buffer.data());
+}
+
+void RemoteCommandEncoder::appendValue(int value)
+{
+    auto result = std::to_chars(this->buffer.data() + this->length, this->buffer.data() + this->buffer.size(), value);
+    if (result.ec != std::errc())
+    {
+        throw ThalesRemoteError("Remote command is too long.");
+    }
+    this->length = static_cast<size_t>(result.ptr - this->buffer.data());
+}
+
+void RemoteCommandEncoder::appendValue(bool value)
+{
+    this->append(value == true ? "1" : "0");
+}
+
+void RemoteCommandEncoder::appendValue(std::string_view value)
+{
+    this->append(value);
+}
+
+void RemoteCommandEncoder::appendValue(const char* value)
+{
+    this->append(std::string_view(value));
+}
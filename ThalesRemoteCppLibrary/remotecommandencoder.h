@@ -0,0 +1,93 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMOTECOMMANDENCODER_H
+#define REMOTECOMMANDENCODER_H
+
+#include <array>
+#include <string_view>
+
+/** The RemoteCommandEncoder class
+ *
+ *  Formats Remote2 commands directly into a reusable buffer.
+ *
+ *  The encoded command already contains the "1:" prefix and the ":" suffix which are needed for the
+ *  Remote Script telegram, so it can be sent without further copies.
+ *  Numbers are formatted with std::to_chars, so encoding a command does not allocate memory.
+ *
+ *  The returned std::string_view points into the internal buffer and is valid until the next call.
+ */
+class RemoteCommandEncoder
+{
+public:
+    static constexpr size_t bufferSize = 1024;
+
+    RemoteCommandEncoder();
+
+    /** Encode a command without parameter value, e.g. "IMPEDANCE" or "Pot=0".
+     *
+     * \param  command The command string.
+     *
+     * \return The encoded telegram payload.
+     */
+    std::string_view encodeCommand(std::string_view command);
+
+    /** Encode the assignment of one or more values to a parameter.
+     *
+     *  Several values are separated by ";", e.g. encodeParameter("PAD4", 1, 2, true) results in "1:PAD4=1;2;1:".
+     *
+     * \param  name Name of the Remote2 parameter.
+     * \param  values The values to assign.
+     *
+     * \return The encoded telegram payload.
+     */
+    template <typename... Values>
+    std::string_view encodeParameter(std::string_view name, const Values&... values)
+    {
+        this->begin();
+        this->append(name);
+        this->append("=");
+        bool first = true;
+        ((first ? (void)(first = false) : this->append(";"), this->appendValue(values)), ...);
+        return this->end();
+    }
+
+private:
+    void begin();
+    std::string_view end();
+
+    void append(std::string_view text);
+    void appendValue(double value);
+    void appendValue(int value);
+    void appendValue(bool value);
+    void appendValue(std::string_view value);
+    void appendValue(const char* value);
+
+    std::array<char, bufferSize> buffer;
+    size_t length;
+};
+
+#endif // REMOTECOMMANDENCODER_H
@@ -0,0 +1,178 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMOTEPARAMETERS_H
+#define REMOTEPARAMETERS_H
+
+#include <string_view>
+
+/** Names of the Remote2 parameters and commands.
+ *
+ *  The names are compile-time constants, so no string has to be constructed to address a parameter.
+ *  The parameters are explained in https://doc.zahner.de/manuals/remote2.pdf .
+ */
+namespace RemoteParameter {
+
+/*
+ * Potentiostat and general settings
+ */
+constexpr std::string_view Cset = "Cset";
+constexpr std::string_view Pset = "Pset";
+constexpr std::string_view Rmax = "Rmax";
+constexpr std::string_view Rmin = "Rmin";
+constexpr std::string_view Potrange = "Potrange";
+constexpr std::string_view DEV = "DEV%";
+constexpr std::string_view DEVHOT = "DEVHOT%";
+constexpr std::string_view UseRuleFile = "UseRuleFile";
+constexpr std::string_view Pot = "Pot";
+constexpr std::string_view Gal = "Gal";
+constexpr std::string_view GAL = "GAL";
+
+/*
+ * PAD4
+ */
+constexpr std::string_view PAD4MOD = "PAD4MOD";
+constexpr std::string_view PAD4ENA = "PAD4ENA";
+constexpr std::string_view PAD4 = "PAD4";
+constexpr std::string_view PAD4_PRANGE = "PAD4_PRANGE";
+constexpr std::string_view PAD4_RSHUNT = "PAD4_RSHUNT";
+
+/*
+ * Single impedance and EIS
+ */
+constexpr std::string_view Frq = "Frq";
+constexpr std::string_view Ampl = "Ampl";
+constexpr std::string_view Nw = "Nw";
+constexpr std::string_view Fmax = "Fmax";
+constexpr std::string_view Fmin = "Fmin";
+constexpr std::string_view Fstart = "Fstart";
+constexpr std::string_view dfm = "dfm";
+constexpr std::string_view dfl = "dfl";
+constexpr std::string_view Nws = "Nws";
+constexpr std::string_view Nwl = "Nwl";
+constexpr std::string_view ScanStrategy = "ScanStrategy";
+constexpr std::string_view ScanDirection = "ScanDirection";
+constexpr std::string_view EIS_MOD = "EIS_MOD";
+constexpr std::string_view EIS_NUM = "EIS_NUM";
+constexpr std::string_view EIS_PATH = "EIS_PATH";
+constexpr std::string_view EIS_ROOT = "EIS_ROOT";
+
+/*
+ * CV
+ */
+constexpr std::string_view CV_Pstart = "CV_Pstart";
+constexpr std::string_view CV_Pupper = "CV_Pupper";
+constexpr std::string_view CV_Plower = "CV_Plower";
+constexpr std::string_view CV_Pend = "CV_Pend";
+constexpr std::string_view CV_Tstart = "CV_Tstart";
+constexpr std::string_view CV_Tend = "CV_Tend";
+constexpr std::string_view CV_Srate = "CV_Srate";
+constexpr std::string_view CV_Periods = "CV_Periods";
+constexpr std::string_view CV_PpPer = "CV_PpPer";
+constexpr std::string_view CV_Ima = "CV_Ima";
+constexpr std::string_view CV_Imi = "CV_Imi";
+constexpr std::string_view CV_Odrop = "CV_Odrop";
+constexpr std::string_view CV_AutoReStart = "CV_AutoReStart";
+constexpr std::string_view CV_AutoScale = "CV_AutoScale";
+constexpr std::string_view CV_AFGena = "CV_AFGena";
+constexpr std::string_view CV_MOD = "CV_MOD";
+constexpr std::string_view CV_NUM = "CV_NUM";
+constexpr std::string_view CV_PATH = "CV_PATH";
+constexpr std::string_view CV_ROOT = "CV_ROOT";
+
+/*
+ * IE
+ */
+constexpr std::string_view IE_EckPot1 = "IE_EckPot1";
+constexpr std::string_view IE_EckPot2 = "IE_EckPot2";
+constexpr std::string_view IE_EckPot3 = "IE_EckPot3";
+constexpr std::string_view IE_EckPot4 = "IE_EckPot4";
+constexpr std::string_view IE_EckPot1rel = "IE_EckPot1rel";
+constexpr std::string_view IE_EckPot2rel = "IE_EckPot2rel";
+constexpr std::string_view IE_EckPot3rel = "IE_EckPot3rel";
+constexpr std::string_view IE_EckPot4rel = "IE_EckPot4rel";
+constexpr std::string_view IE_Resolution = "IE_Resolution";
+constexpr std::string_view IE_WZmin = "IE_WZmin";
+constexpr std::string_view IE_WZmax = "IE_WZmax";
+constexpr std::string_view IE_Torel = "IE_Torel";
+constexpr std::string_view IE_Toabs = "IE_Toabs";
+constexpr std::string_view IE_Odrop = "IE_Odrop";
+constexpr std::string_view IE_SweepMode = "IE_SweepMode";
+constexpr std::string_view IE_Srate = "IE_Srate";
+constexpr std::string_view IE_Ima = "IE_Ima";
+constexpr std::string_view IE_Imi = "IE_Imi";
+constexpr std::string_view IE_MOD = "IE_MOD";
+constexpr std::string_view IE_NUM = "IE_NUM";
+constexpr std::string_view IE_PATH = "IE_PATH";
+constexpr std::string_view IE_ROOT = "IE_ROOT";
+
+/*
+ * Sequencer
+ */
+constexpr std::string_view SEQ_MOD = "SEQ_MOD";
+constexpr std::string_view SEQ_NUM = "SEQ_NUM";
+constexpr std::string_view SEQ_PATH = "SEQ_PATH";
+constexpr std::string_view SEQ_ROOT = "SEQ_ROOT";
+constexpr std::string_view SEQ_ACQENA = "SEQ_ACQENA";
+constexpr std::string_view SEQ_RODROP = "SEQ_RODROP";
+constexpr std::string_view SEQ_MAXTIME = "SEQ_MAXTIME";
+constexpr std::string_view SEQ_EUPPER = "SEQ_EUPPER";
+constexpr std::string_view SEQ_ELOWER = "SEQ_ELOWER";
+constexpr std::string_view SEQ_IUPPER = "SEQ_IUPPER";
+constexpr std::string_view SEQ_ILOWER = "SEQ_ILOWER";
+constexpr std::string_view SEQ_IRANGE = "SEQ_IRANGE";
+constexpr std::string_view SEQ_POTOFLO = "SEQ_POTOFLO";
+constexpr std::string_view SEQ_CUROFLO = "SEQ_CUROFLO";
+constexpr std::string_view SEQ_ACQ = "SEQ_ACQ";
+constexpr std::string_view SELSEQ = "SELSEQ";
+
+/*
+ * FRA
+ */
+constexpr std::string_view FRA = "FRA";
+constexpr std::string_view FRA_POT_IN = "FRA_POT_IN";
+constexpr std::string_view FRA_POT_IN_OFF = "FRA_POT_IN_OFF";
+constexpr std::string_view FRA_POT_OUT = "FRA_POT_OUT";
+constexpr std::string_view FRA_POT_OUT_OFF = "FRA_POT_OUT_OFF";
+constexpr std::string_view FRA_POT_MIN = "FRA_POT_MIN";
+constexpr std::string_view FRA_POT_MAX = "FRA_POT_MAX";
+constexpr std::string_view FRA_CUR_IN = "FRA_CUR_IN";
+constexpr std::string_view FRA_CUR_IN_OFF = "FRA_CUR_IN_OFF";
+constexpr std::string_view FRA_CUR_OUT = "FRA_CUR_OUT";
+constexpr std::string_view FRA_CUR_OUT_OFF = "FRA_CUR_OUT_OFF";
+constexpr std::string_view FRA_CUR_MIN = "FRA_CUR_MIN";
+constexpr std::string_view FRA_CUR_MAX = "FRA_CUR_MAX";
+constexpr std::string_view FRAGAL = "FRAGAL";
+
+/*
+ * ACQ
+ */
+constexpr std::string_view CHANNEL = "CHANNEL";
+constexpr std::string_view ACQENA = "ACQENA";
+
+} // namespace RemoteParameter
+
+#endif // REMOTEPARAMETERS_H
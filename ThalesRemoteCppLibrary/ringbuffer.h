@@ -0,0 +1,151 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/** Thread-safe ring buffer with a fixed capacity.
+ *
+ *  The memory for all elements is allocated in the constructor. If the buffer is full, the oldest
+ *  element is overwritten and counted as dropped, so a slow reader never blocks the writer.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+    /** Constructor.
+     *
+     * \param  capacity Maximum number of elements, at least 1.
+     */
+    explicit RingBuffer(size_t capacity) :
+        elements(capacity > 0 ? capacity : 1),
+        head(0),
+        count(0),
+        dropped(0)
+    {
+
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer& operator=(const RingBuffer &) = delete;
+
+    /** Add an element, the oldest element is overwritten if the buffer is full.
+     *
+     * \param  element The element to add.
+     */
+    void push(T element)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        const size_t tail = (this->head + this->count) % this->elements.size();
+        this->elements[tail] = std::move(element);
+
+        if (this->count == this->elements.size())
+        {
+            this->head = (this->head + 1) % this->elements.size();
+            this->dropped++;
+        }
+        else
+        {
+            this->count++;
+        }
+    }
+
+    /** Remove the oldest element.
+     *
+     * \param  element Receives the element.
+     *
+     * \return false if the buffer was empty.
+     */
+    bool pop(T& element)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (this->count == 0)
+        {
+            return false;
+        }
+
+        element = std::move(this->elements[this->head]);
+        this->head = (this->head + 1) % this->elements.size();
+        this->count--;
+        return true;
+    }
+
+    /** Move all elements into a vector, oldest first.
+     *
+     * \param  destination The elements are appended to this vector.
+     *
+     * \return The number of elements moved.
+     */
+    size_t drain(std::vector<T>& destination)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        const size_t retval = this->count;
+        destination.reserve(destination.size() + this->count);
+        while (this->count > 0)
+        {
+            destination.push_back(std::move(this->elements[this->head]));
+            this->head = (this->head + 1) % this->elements.size();
+            this->count--;
+        }
+        return retval;
+    }
+
+    /** Get the number of elements in the buffer. */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->count;
+    }
+
+    /** Get the maximum number of elements. */
+    size_t capacity() const
+    {
+        return this->elements.size();
+    }
+
+    /** Get the number of elements which were overwritten before they were read. */
+    unsigned long getDropped() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->dropped;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<T> elements;
+    size_t head;
+    size_t count;
+    unsigned long dropped;
+};
+
+#endif // RINGBUFFER_H
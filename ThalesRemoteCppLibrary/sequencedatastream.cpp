@@ -0,0 +1,171 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "sequencedatastream.h"
+#include "termeventstream.h"
+#include "thalesremotescriptwrapper.h"
+
+SequenceDataStream::SequenceDataStream(ThalesRemoteScriptWrapper* const wrapper, TermEventStream* const events, ThalesFileInterface* const files) :
+    wrapper(wrapper),
+    events(events),
+    files(files),
+    measurement(wrapper),
+    streaming(false),
+    subscriptionId(0)
+{
+
+}
+
+SequenceDataStream::~SequenceDataStream()
+{
+    this->measurement.cancel();
+    this->stop();
+}
+
+void SequenceDataStream::setValueCallback(ValueCallback callback)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->valueCallback = std::move(callback);
+}
+
+void SequenceDataStream::setFileCallback(FileCallback callback)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->fileCallback = std::move(callback);
+}
+
+std::shared_future<std::string> SequenceDataStream::start(const std::chrono::milliseconds timeout, std::string fileExtensions)
+{
+    this->stop();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->data = Data();
+        this->startTime = std::chrono::steady_clock::now();
+    }
+
+    if (this->events != nullptr)
+    {
+        this->subscriptionId = this->events->subscribe([this](const TermEvent& event) { this->onEvent(event); });
+    }
+    if (this->files != nullptr)
+    {
+        this->files->setFileReceivedCallback([this](const ThalesFileInterface::FileObject& file) { this->onFile(file); });
+        this->files->enableAutomaticFileExchange(true, fileExtensions);
+    }
+    this->streaming = true;
+
+    try {
+        this->future = this->measurement.startSequence(timeout);
+    }  catch (...) {
+        this->stop();
+        throw;
+    }
+    return this->future;
+}
+
+void SequenceDataStream::stop()
+{
+    if (this->streaming == false)
+    {
+        return;
+    }
+    this->streaming = false;
+
+    if (this->files != nullptr)
+    {
+        this->files->disableAutomaticFileExchange();
+        this->files->setFileReceivedCallback(nullptr);
+    }
+    if (this->events != nullptr)
+    {
+        this->events->unsubscribe(this->subscriptionId);
+    }
+}
+
+std::string SequenceDataStream::wait()
+{
+    this->measurement.wait();
+    this->stop();
+    return this->future.get();
+}
+
+bool SequenceDataStream::isRunning() const
+{
+    return this->measurement.getState() == AsyncMeasurement::State::RUNNING;
+}
+
+SequenceDataStream::Data SequenceDataStream::getData() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->data;
+}
+
+SequenceDataStream::Data SequenceDataStream::takeData()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Data retval = std::move(this->data);
+    this->data = Data();
+    return retval;
+}
+
+void SequenceDataStream::onEvent(const TermEvent& event)
+{
+    if (event.type != TermEvent::Type::MEASURED_VALUE)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    const double time = this->elapsed(event.time);
+    auto& column = this->data.columns[event.name];
+    column.time.push_back(time);
+    column.value.push_back(event.value);
+
+    if (this->valueCallback)
+    {
+        this->valueCallback(event.name, time, event.value);
+    }
+}
+
+void SequenceDataStream::onFile(const ThalesFileInterface::FileObject& file)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ReceivedFile received;
+    received.time = this->elapsed(std::chrono::steady_clock::now());
+    received.file = file;
+    this->data.files.push_back(std::move(received));
+
+    if (this->fileCallback)
+    {
+        this->fileCallback(this->data.files.back());
+    }
+}
+
+double SequenceDataStream::elapsed(std::chrono::steady_clock::time_point time) const
+{
+    return std::chrono::duration<double>(time - this->startTime).count();
+}
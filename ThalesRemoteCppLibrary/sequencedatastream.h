@@ -0,0 +1,177 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SEQUENCEDATASTREAM_H
+#define SEQUENCEDATASTREAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "asyncmeasurement.h"
+#include "thalesfileinterface.h"
+
+class ThalesRemoteScriptWrapper;
+class TermEventStream;
+class TermEvent;
+
+/** The SequenceDataStream class
+ *
+ *  Collects the data of a running sequence incrementally instead of only at the end.
+ *
+ *  The Remote Script connection is blocked while the sequence runs. The acquisition values are therefore
+ *  taken from a TermEventStream on a Watch or Logging connection, which reports the values the sequence
+ *  acquires with enableSequenceAcqGlobal and enableSequenceAcqChannel. Each measured value is appended to
+ *  a column with the name of the value. The files which the sequence produces are transferred with the
+ *  automatic file exchange of a ThalesFileInterface as soon as they are written and are kept in the stream.
+ *
+ *  Both sources are optional. The callbacks are executed in the receiving threads of the sources.
+ */
+class SequenceDataStream
+{
+public:
+    class Column
+    {
+    public:
+        std::vector<double> time;   /**< Time of the value in seconds since the start of the stream. */
+        std::vector<double> value;  /**< The values. */
+    };
+
+    class ReceivedFile
+    {
+    public:
+        double time = 0.0;                      /**< Time of arrival in seconds since the start of the stream. */
+        ThalesFileInterface::FileObject file;   /**< The file. */
+    };
+
+    class Data
+    {
+    public:
+        std::map<std::string, Column> columns;  /**< One column per value name. */
+        std::vector<ReceivedFile> files;        /**< Received files in order of arrival. */
+    };
+
+    typedef std::function<void(const std::string&, double, double)> ValueCallback;
+    typedef std::function<void(const ReceivedFile&)> FileCallback;
+
+    /** Constructor.
+     *
+     * \param  wrapper The ThalesRemoteScriptWrapper which runs the sequence.
+     * \param  events The event stream of a Watch or Logging connection or nullptr.
+     * \param  files The file interface for the automatic file exchange or nullptr.
+     */
+    SequenceDataStream(ThalesRemoteScriptWrapper* const wrapper, TermEventStream* const events, ThalesFileInterface* const files);
+
+    /** The destructor stops waiting for the sequence and stops the stream. */
+    ~SequenceDataStream();
+
+    SequenceDataStream(const SequenceDataStream &) = delete;
+    SequenceDataStream& operator=(const SequenceDataStream &) = delete;
+
+    /** Set the function which is called with name, time and value of each acquired value. */
+    void setValueCallback(ValueCallback callback);
+
+    /** Set the function which is called for each received file. */
+    void setFileCallback(FileCallback callback);
+
+    /** Start the collection and the sequence selected with ThalesRemoteScriptWrapper::selectSequence.
+     *
+     *  Previously collected data is discarded. The automatic file exchange is enabled with the given extensions.
+     *
+     * \param  timeout Maximum time to wait for the end of the sequence, zero to wait without limit.
+     * \param  fileExtensions The file extensions for the automatic file exchange.
+     *
+     * \return The future which receives the response of the sequence.
+     */
+    std::shared_future<std::string> start(const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero(),
+                                          std::string fileExtensions = "*.ism*.isc*.isw");
+
+    /** Stop the collection.
+     *
+     *  The automatic file exchange is disabled. Files still in transfer are received before. The collected
+     *  data remains in the object. The sequence itself is not aborted, see AsyncMeasurement.
+     */
+    void stop();
+
+    /** Wait for the end of the sequence and stop the collection.
+     *
+     * \return The response of the sequence.
+     */
+    std::string wait();
+
+    /** Check if the sequence is still running.
+     *
+     * \return true if running.
+     */
+    bool isRunning() const;
+
+    /** Copy of the data collected so far.
+     *
+     * \return The data.
+     */
+    Data getData() const;
+
+    /** Move the collected data out of the object.
+     *
+     *  The internal store is empty afterwards, the collection continues.
+     *
+     * \return The data.
+     */
+    Data takeData();
+
+private:
+    /** Subscriber of the event stream. */
+    void onEvent(const TermEvent& event);
+
+    /** Callback of the file interface. */
+    void onFile(const ThalesFileInterface::FileObject& file);
+
+    /** Seconds since the start of the stream. */
+    double elapsed(std::chrono::steady_clock::time_point time) const;
+
+    ThalesRemoteScriptWrapper* const wrapper;
+    TermEventStream* const events;
+    ThalesFileInterface* const files;
+
+    AsyncMeasurement measurement;
+    std::shared_future<std::string> future;
+
+    std::chrono::steady_clock::time_point startTime;
+    bool streaming;
+    uint64_t subscriptionId;
+
+    ValueCallback valueCallback;
+    FileCallback fileCallback;
+
+    mutable std::mutex mutex;
+    Data data;
+};
+
+#endif // SEQUENCEDATASTREAM_H
@@ -0,0 +1,199 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "setupsnapshot.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+/** Relative tolerance for the comparison of numbers, the setup reply has five significant digits. */
+static constexpr double relativeTolerance = 1e-4;
+
+static std::string_view trim(std::string_view string)
+{
+    while (string.empty() == false && (string.front() == ' ' || string.front() == '\r' || string.front() == '\n'))
+    {
+        string.remove_prefix(1);
+    }
+    while (string.empty() == false && (string.back() == ' ' || string.back() == '\r' || string.back() == '\n'))
+    {
+        string.remove_suffix(1);
+    }
+    return string;
+}
+
+static double parseNumber(std::string_view string)
+{
+    string = trim(string);
+    if (string.empty() == false && string.front() == '+')
+    {
+        string.remove_prefix(1);
+    }
+
+    double value;
+    auto result = std::from_chars(string.data(), string.data() + string.size(), value);
+    if (result.ec != std::errc() || result.ptr != string.data() + string.size())
+    {
+        return std::nan("1");
+    }
+    return value;
+}
+
+static bool isMarker(std::string_view token)
+{
+    if (token.empty() == true)
+    {
+        return true;
+    }
+    for (char character : token)
+    {
+        if (character < 'A' || character > 'Z')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool valuesEqual(const SetupSnapshot::Entry& a, const SetupSnapshot::Entry& b)
+{
+    if (std::isnan(a.number) == false && std::isnan(b.number) == false)
+    {
+        const double scale = std::max(std::abs(a.number), std::abs(b.number));
+        return std::abs(a.number - b.number) <= relativeTolerance * scale;
+    }
+    return a.value == b.value;
+}
+
+SetupSnapshot SetupSnapshot::fromReply(std::string_view reply)
+{
+    SetupSnapshot retval;
+    size_t previous = std::string_view::npos;
+
+    while (reply.empty() == false)
+    {
+        const size_t separator = reply.find(';');
+        const std::string_view token = trim(reply.substr(0, separator));
+        reply.remove_prefix(separator == std::string_view::npos ? reply.size() : separator + 1);
+
+        const size_t equal = token.find('=');
+        if (equal != std::string_view::npos)
+        {
+            const std::string_view key = trim(token.substr(0, equal));
+            retval.set(key, trim(token.substr(equal + 1)));
+            previous = retval.index[std::string(key)];
+        }
+        else if (isMarker(token) == false && previous != std::string_view::npos)
+        {
+            Entry& entry = retval.entries[previous];
+            entry.value += ';';
+            entry.value += token;
+            entry.number = std::nan("1");
+        }
+    }
+
+    return retval;
+}
+
+void SetupSnapshot::merge(const SetupSnapshot& other)
+{
+    for (const auto& entry : other.entries)
+    {
+        this->set(entry.key, entry.value);
+    }
+}
+
+void SetupSnapshot::set(std::string_view key, std::string_view value)
+{
+    auto it = this->index.find(std::string(key));
+    if (it != this->index.end())
+    {
+        Entry& entry = this->entries[it->second];
+        entry.value = std::string(value);
+        entry.number = parseNumber(value);
+    }
+    else
+    {
+        this->index.emplace(std::string(key), this->entries.size());
+        this->entries.push_back(Entry{std::string(key), std::string(value), parseNumber(value)});
+    }
+}
+
+bool SetupSnapshot::contains(std::string_view key) const
+{
+    return this->index.find(std::string(key)) != this->index.end();
+}
+
+std::string SetupSnapshot::getString(std::string_view key) const
+{
+    auto it = this->index.find(std::string(key));
+    if (it == this->index.end())
+    {
+        return std::string();
+    }
+    return this->entries[it->second].value;
+}
+
+double SetupSnapshot::getDouble(std::string_view key) const
+{
+    auto it = this->index.find(std::string(key));
+    if (it == this->index.end())
+    {
+        return std::nan("1");
+    }
+    return this->entries[it->second].number;
+}
+
+int SetupSnapshot::getInt(std::string_view key, int defaultValue) const
+{
+    const double value = this->getDouble(key);
+    if (std::isnan(value))
+    {
+        return defaultValue;
+    }
+    return static_cast<int>(std::lround(value));
+}
+
+const std::vector<SetupSnapshot::Entry>& SetupSnapshot::getEntries() const
+{
+    return this->entries;
+}
+
+std::vector<SetupSnapshot::Entry> SetupSnapshot::differencesTo(const SetupSnapshot& current) const
+{
+    std::vector<Entry> retval;
+
+    for (const auto& entry : this->entries)
+    {
+        auto it = current.index.find(entry.key);
+        if (it == current.index.end() || valuesEqual(entry, current.entries[it->second]) == false)
+        {
+            retval.push_back(entry);
+        }
+    }
+
+    return retval;
+}
@@ -0,0 +1,137 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SETUPSNAPSHOT_H
+#define SETUPSNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/** The SetupSnapshot class
+ *
+ *  Parsed form of the setup strings returned by ThalesRemoteScriptWrapper::readSetup, readCVSetup,
+ *  readIESetup, readPAD4Setup, readFraSetup and readSequenceAcqSetup.
+ *
+ *  A reply like "OK;SETUP;Pset=1.0000e-05;Cset=1.0000e-06;...;ENDSETUP" is split into key/value entries.
+ *  Markers without "=" like OK, SETUP and ENDSETUP are ignored. Other tokens without "=" belong to
+ *  multi-value parameters and are appended to the previous value, separated by ";".
+ *
+ *  The entries keep the order of the reply, because this is also the order in which Thales expects
+ *  dependent parameters to be set.
+ */
+class SetupSnapshot
+{
+public:
+    class Entry
+    {
+    public:
+        std::string key;    /**< Name of the Remote2 parameter. */
+        std::string value;  /**< Value as sent by Thales. */
+        double number;      /**< Value as number or NaN if the value is not numeric. */
+    };
+
+    /** Parse a setup reply.
+     *
+     * \param  reply The response string from the device.
+     *
+     * \return The parsed snapshot.
+     */
+    static SetupSnapshot fromReply(std::string_view reply);
+
+    /** Add the entries of another snapshot, for example of a different setup reply.
+     *
+     *  Existing keys are overwritten.
+     *
+     * \param  other The snapshot to add.
+     */
+    void merge(const SetupSnapshot& other);
+
+    /** Set a value. An existing key is overwritten.
+     *
+     * \param  key Name of the Remote2 parameter.
+     * \param  value The value.
+     */
+    void set(std::string_view key, std::string_view value);
+
+    /** Check if a key is contained.
+     *
+     * \param  key Name of the Remote2 parameter.
+     *
+     * \return true if the key exists.
+     */
+    bool contains(std::string_view key) const;
+
+    /** Get a value as string.
+     *
+     * \param  key Name of the Remote2 parameter.
+     *
+     * \return The value or an empty string if the key does not exist.
+     */
+    std::string getString(std::string_view key) const;
+
+    /** Get a value as number.
+     *
+     * \param  key Name of the Remote2 parameter.
+     *
+     * \return The value or NaN if the key does not exist or the value is not numeric.
+     */
+    double getDouble(std::string_view key) const;
+
+    /** Get a value as integer.
+     *
+     * \param  key Name of the Remote2 parameter.
+     * \param  defaultValue Returned if the key does not exist or the value is not numeric.
+     *
+     * \return The value.
+     */
+    int getInt(std::string_view key, int defaultValue = 0) const;
+
+    /** Get all entries in the order of the reply.
+     *
+     * \return The entries.
+     */
+    const std::vector<Entry>& getEntries() const;
+
+    /** Get the entries of this snapshot which differ from another snapshot.
+     *
+     *  Numbers are compared with a relative tolerance, because Thales rounds the values to
+     *  five significant digits in the setup reply. Keys missing in the other snapshot are
+     *  always returned.
+     *
+     * \param  current The snapshot to compare with, usually the current state of the device.
+     *
+     * \return The entries which must be set to reach this snapshot.
+     */
+    std::vector<Entry> differencesTo(const SetupSnapshot& current) const;
+
+private:
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, size_t> index;
+};
+
+#endif // SETUPSNAPSHOT_H
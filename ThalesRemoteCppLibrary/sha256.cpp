@@ -0,0 +1,191 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "sha256.h"
+#include <algorithm>
+#include <cstring>
+
+static constexpr uint32_t roundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotateRight(uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+Sha256::Sha256()
+{
+    this->reset();
+}
+
+void Sha256::reset()
+{
+    this->state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    this->bufferSize = 0;
+    this->totalSize = 0;
+}
+
+void Sha256::update(const uint8_t* data, size_t size)
+{
+    this->totalSize += size;
+
+    if (this->bufferSize > 0)
+    {
+        const size_t count = std::min(size, this->buffer.size() - this->bufferSize);
+        std::memcpy(this->buffer.data() + this->bufferSize, data, count);
+        this->bufferSize += count;
+        data += count;
+        size -= count;
+
+        if (this->bufferSize < this->buffer.size())
+        {
+            return;
+        }
+        this->processBlock(this->buffer.data());
+        this->bufferSize = 0;
+    }
+
+    while (size >= this->buffer.size())
+    {
+        this->processBlock(data);
+        data += this->buffer.size();
+        size -= this->buffer.size();
+    }
+
+    if (size > 0)
+    {
+        std::memcpy(this->buffer.data(), data, size);
+        this->bufferSize = size;
+    }
+}
+
+Sha256::Digest Sha256::finish()
+{
+    const uint64_t totalBits = this->totalSize * 8;
+
+    const uint8_t padding = 0x80;
+    this->update(&padding, 1);
+    const uint8_t zero = 0x00;
+    while (this->bufferSize != 56)
+    {
+        this->update(&zero, 1);
+    }
+
+    uint8_t length[8];
+    for (int i = 0; i < 8; i++)
+    {
+        length[i] = static_cast<uint8_t>(totalBits >> (56 - 8 * i));
+    }
+    this->update(length, 8);
+
+    Digest retval;
+    for (size_t i = 0; i < this->state.size(); i++)
+    {
+        retval[4 * i] = static_cast<uint8_t>(this->state[i] >> 24);
+        retval[4 * i + 1] = static_cast<uint8_t>(this->state[i] >> 16);
+        retval[4 * i + 2] = static_cast<uint8_t>(this->state[i] >> 8);
+        retval[4 * i + 3] = static_cast<uint8_t>(this->state[i]);
+    }
+
+    this->reset();
+    return retval;
+}
+
+std::string Sha256::toHex(const Digest& digest)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string retval;
+    retval.reserve(digest.size() * 2);
+    for (auto byte : digest)
+    {
+        retval.push_back(digits[byte >> 4]);
+        retval.push_back(digits[byte & 0x0f]);
+    }
+    return retval;
+}
+
+void Sha256::processBlock(const uint8_t* block)
+{
+    uint32_t schedule[64];
+    for (int i = 0; i < 16; i++)
+    {
+        schedule[i] = (static_cast<uint32_t>(block[4 * i]) << 24) |
+                      (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+                      (static_cast<uint32_t>(block[4 * i + 2]) << 8) |
+                      static_cast<uint32_t>(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; i++)
+    {
+        const uint32_t s0 = rotateRight(schedule[i - 15], 7) ^ rotateRight(schedule[i - 15], 18) ^ (schedule[i - 15] >> 3);
+        const uint32_t s1 = rotateRight(schedule[i - 2], 17) ^ rotateRight(schedule[i - 2], 19) ^ (schedule[i - 2] >> 10);
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+
+    uint32_t a = this->state[0];
+    uint32_t b = this->state[1];
+    uint32_t c = this->state[2];
+    uint32_t d = this->state[3];
+    uint32_t e = this->state[4];
+    uint32_t f = this->state[5];
+    uint32_t g = this->state[6];
+    uint32_t h = this->state[7];
+
+    for (int i = 0; i < 64; i++)
+    {
+        const uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        const uint32_t choice = (e & f) ^ (~e & g);
+        const uint32_t temp1 = h + s1 + choice + roundConstants[i] + schedule[i];
+        const uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    this->state[0] += a;
+    this->state[1] += b;
+    this->state[2] += c;
+    this->state[3] += d;
+    this->state[4] += e;
+    this->state[5] += f;
+    this->state[6] += g;
+    this->state[7] += h;
+}
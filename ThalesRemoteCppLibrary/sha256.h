@@ -0,0 +1,82 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** The Sha256 class
+ *
+ *  Incremental SHA-256 hash according to FIPS 180-4.
+ *
+ *  The data can be passed in chunks of any size, so a file can be hashed while it is received.
+ */
+class Sha256
+{
+public:
+    typedef std::array<uint8_t, 32> Digest;
+
+    Sha256();
+
+    /** Add data to the hash.
+     *
+     * \param  data Pointer to the data.
+     * \param  size Size of the data in bytes.
+     */
+    void update(const uint8_t* data, size_t size);
+
+    /** Finish the hash. The object is reset afterwards.
+     *
+     * \return The digest.
+     */
+    Digest finish();
+
+    /** Reset the object for a new hash. */
+    void reset();
+
+    /** Convert a digest into lower case hexadecimal text.
+     *
+     * \param  digest The digest.
+     *
+     * \return The text with 64 characters.
+     */
+    static std::string toHex(const Digest& digest);
+
+private:
+    /** Process one block of 64 bytes. */
+    void processBlock(const uint8_t* block);
+
+    std::array<uint32_t, 8> state;
+    std::array<uint8_t, 64> buffer;
+    size_t bufferSize;
+    uint64_t totalSize;
+};
+
+#endif // SHA256_H
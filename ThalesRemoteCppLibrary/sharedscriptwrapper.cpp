@@ -0,0 +1,129 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "sharedscriptwrapper.h"
+#include "thalesremotescriptwrapper.h"
+
+SharedScriptWrapper::SharedScriptWrapper(ThalesRemoteScriptWrapper* const wrapper) :
+    wrapper(wrapper),
+    readSequence(0),
+    coalescedReads(0),
+    strand_worker_is_running(true)
+{
+    this->strandWorker = new std::thread(&SharedScriptWrapper::strandJob, this);
+}
+
+SharedScriptWrapper::~SharedScriptWrapper()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->strand_worker_is_running = false;
+    }
+    this->taskAvailable.notify_all();
+    this->strandWorker->join();
+    delete this->strandWorker;
+}
+
+std::future<std::string> SharedScriptWrapper::execute(std::string command)
+{
+    return this->submit([command = std::move(command)](ThalesRemoteScriptWrapper& wrapper) {
+        return wrapper.executeRemoteCommand(command);
+    });
+}
+
+std::shared_future<std::string> SharedScriptWrapper::read(std::string command)
+{
+    return this->coalesce<std::string>(command, [command](ThalesRemoteScriptWrapper& wrapper) {
+        return wrapper.executeRemoteCommand(command);
+    });
+}
+
+double SharedScriptWrapper::getPotential()
+{
+    return this->coalesce<double>("POTENTIAL", [](ThalesRemoteScriptWrapper& wrapper) {
+        return wrapper.getPotential();
+    }).get();
+}
+
+double SharedScriptWrapper::getCurrent()
+{
+    return this->coalesce<double>("CURRENT", [](ThalesRemoteScriptWrapper& wrapper) {
+        return wrapper.getCurrent();
+    }).get();
+}
+
+std::complex<double> SharedScriptWrapper::getImpedance()
+{
+    return this->coalesce<std::complex<double>>("IMPEDANCE", [](ThalesRemoteScriptWrapper& wrapper) {
+        return wrapper.getImpedance();
+    }).get();
+}
+
+unsigned long SharedScriptWrapper::getCoalescedReads() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->coalescedReads;
+}
+
+void SharedScriptWrapper::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push_back(std::move(task));
+
+        /*
+         * Reads queued before this task may be executed before a write in it, so later reads must not join them.
+         */
+        this->pendingReads.clear();
+    }
+    this->taskAvailable.notify_one();
+}
+
+void SharedScriptWrapper::strandJob()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [this]() {
+                return this->tasks.empty() == false || this->strand_worker_is_running == false;
+            });
+
+            if (this->tasks.empty() == true)
+            {
+                return;
+            }
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+
+        /*
+         * Exceptions of the function are stored in the future by the packaged task.
+         */
+        task();
+    }
+}
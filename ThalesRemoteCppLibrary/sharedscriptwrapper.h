@@ -0,0 +1,207 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SHAREDSCRIPTWRAPPER_H
+#define SHAREDSCRIPTWRAPPER_H
+
+#include <any>
+#include <complex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+
+class ThalesRemoteScriptWrapper;
+
+/** The SharedScriptWrapper class
+ *
+ *  Thread-safe facade for a ThalesRemoteScriptWrapper which is shared by several threads.
+ *
+ *  The ThalesRemoteScriptWrapper has no synchronization: if two threads send commands on the same connection,
+ *  each of them may read the response of the other one. This class serializes all access to one instrument
+ *  through a strand, a single worker thread which executes the submitted tasks one after another in the order
+ *  of submission. A command and its response are always executed in one task, so the correlation of request and
+ *  response is kept.
+ *
+ *  Identical read requests which are submitted while an equal read is still waiting in the strand are coalesced:
+ *  all callers receive the result of one round trip. A read which is already being executed is not joined,
+ *  so every result is measured after the request was made. Every task which is not coalesced, e.g. a setter,
+ *  ends the coalescing of the reads queued before it, so a read never returns a value from before a write
+ *  which was submitted earlier.
+ *
+ *  Tasks must not wait for other tasks of the same SharedScriptWrapper, this would block the strand.
+ */
+class SharedScriptWrapper
+{
+public:
+    /** Constructor. Needs a ThalesRemoteScriptWrapper connected to Thales which is not used directly anymore. */
+    SharedScriptWrapper(ThalesRemoteScriptWrapper* const wrapper);
+
+    /** The destructor executes the tasks which are still queued and stops the strand. */
+    ~SharedScriptWrapper();
+
+    SharedScriptWrapper(const SharedScriptWrapper &) = delete;
+    SharedScriptWrapper& operator=(const SharedScriptWrapper &) = delete;
+
+    /** Execute a function with exclusive access to the wrapper.
+     *
+     * \param  function Function which is called with the wrapper in the strand.
+     *
+     * \return The future which receives the return value or the exception of the function.
+     */
+    template <typename Function>
+    auto submit(Function function) -> std::future<std::invoke_result_t<Function, ThalesRemoteScriptWrapper&>>
+    {
+        typedef std::invoke_result_t<Function, ThalesRemoteScriptWrapper&> Result;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            [this, function = std::move(function)]() mutable { return function(*this->wrapper); });
+        auto retval = task->get_future();
+        this->post([task]() { (*task)(); });
+        return retval;
+    }
+
+    /** Execute a read with exclusive access to the wrapper and coalesce it with an identical pending read.
+     *
+     *  If a read with the same key and result type is still waiting in the strand and no other task was submitted
+     *  after it, its future is returned and the function is not queued again. The key must identify the read
+     *  completely.
+     *
+     * \param  key Unique description of the read, e.g. the Remote Script command.
+     * \param  function Function which is called with the wrapper in the strand.
+     *
+     * \return The future which receives the return value or the exception of the function.
+     */
+    template <typename T>
+    std::shared_future<T> coalesce(const std::string& key, std::function<T(ThalesRemoteScriptWrapper&)> function)
+    {
+        /*
+         * The result type is part of the key, so read("POTENTIAL") and getPotential() are not mixed up.
+         */
+        const std::string typedKey = std::string(typeid(T).name()) + ":" + key;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto pending = this->pendingReads.find(typedKey);
+        if (pending != this->pendingReads.end())
+        {
+            this->coalescedReads++;
+            return std::any_cast<std::shared_future<T>>(pending->second.future);
+        }
+
+        const unsigned long id = ++this->readSequence;
+        auto task = std::make_shared<std::packaged_task<T()>>(
+            [this, typedKey, id, function = std::move(function)]() {
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    auto pending = this->pendingReads.find(typedKey);
+                    if (pending != this->pendingReads.end() && pending->second.id == id)
+                    {
+                        this->pendingReads.erase(pending);
+                    }
+                }
+                return function(*this->wrapper);
+            });
+        std::shared_future<T> retval = task->get_future().share();
+        this->pendingReads[typedKey] = PendingRead{id, retval};
+        this->tasks.push_back([task]() { (*task)(); });
+        this->taskAvailable.notify_one();
+        return retval;
+    }
+
+    /** Execute a Remote Script command which changes the state, e.g. "Pot=1.0". This is never coalesced.
+     *
+     * \param  command The Remote Script command.
+     *
+     * \return The future which receives the response string from the device.
+     */
+    std::future<std::string> execute(std::string command);
+
+    /** Execute a Remote Script command which only reads, e.g. "POTENTIAL". Identical pending reads are coalesced.
+     *
+     * \param  command The Remote Script command.
+     *
+     * \return The future which receives the response string from the device.
+     */
+    std::shared_future<std::string> read(std::string command);
+
+    /** Read the potential. Coalesced with concurrent calls.
+     *
+     * \return The potential in V.
+     */
+    double getPotential();
+
+    /** Read the current. Coalesced with concurrent calls.
+     *
+     * \return The current in A.
+     */
+    double getCurrent();
+
+    /** Measure the impedance at the configured frequency. Coalesced with concurrent calls.
+     *
+     * \return The complex impedance.
+     */
+    std::complex<double> getImpedance();
+
+    /** Get the number of reads which were answered by another pending read.
+     *
+     * \return The number of coalesced reads.
+     */
+    unsigned long getCoalescedReads() const;
+
+private:
+    /** A read which is waiting in the strand and can be joined. */
+    struct PendingRead
+    {
+        unsigned long id;
+        std::any future;
+    };
+
+    /** Append a task to the strand, pending reads are no longer joined. */
+    void post(std::function<void()> task);
+
+    /** Function which is executed as strand thread. */
+    void strandJob();
+
+    ThalesRemoteScriptWrapper* const wrapper;
+
+    mutable std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::deque<std::function<void()>> tasks;
+    std::map<std::string, PendingRead> pendingReads;
+    unsigned long readSequence;
+    unsigned long coalescedReads;
+
+    bool strand_worker_is_running;
+    std::thread *strandWorker;
+};
+
+#endif // SHAREDSCRIPTWRAPPER_H
@@ -0,0 +1,203 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "termeventstream.h"
+#include <charconv>
+#include <string_view>
+#include "thalesremoteconnection.h"
+
+/** Channel of the registration and deregistration replies. */
+static constexpr int controlChannel = 0x80;
+
+static std::string_view trim(std::string_view string)
+{
+    while (string.empty() == false && (string.front() == ' ' || string.front() == '\t'))
+    {
+        string.remove_prefix(1);
+    }
+    while (string.empty() == false && (string.back() == ' ' || string.back() == '\t'))
+    {
+        string.remove_suffix(1);
+    }
+    return string;
+}
+
+static bool isText(const std::vector<uint8_t>& payload)
+{
+    for (uint8_t byte : payload)
+    {
+        if (byte < 0x20 && byte != '\r' && byte != '\n' && byte != '\t')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parseNumber(std::string_view string, double& value)
+{
+    if (string.empty() == false && string.front() == '+')
+    {
+        string.remove_prefix(1);
+    }
+    auto result = std::from_chars(string.data(), string.data() + string.size(), value);
+    return result.ec == std::errc() && result.ptr == string.data() + string.size();
+}
+
+void TermEventDecoder::decode(int channel, const std::vector<uint8_t>& payload, std::chrono::steady_clock::time_point time, std::vector<TermEvent>& events)
+{
+    if (isText(payload) == false)
+    {
+        TermEvent event;
+        event.type = TermEvent::Type::RAW;
+        event.channel = channel;
+        event.time = time;
+        event.raw = payload;
+        events.push_back(std::move(event));
+        return;
+    }
+
+    std::string_view text(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+    while (text.empty() == false)
+    {
+        const size_t separator = text.find_first_of(";\r\n");
+        const std::string_view part = trim(text.substr(0, separator));
+        text.remove_prefix(separator == std::string_view::npos ? text.size() : separator + 1);
+
+        if (part.empty() == true)
+        {
+            continue;
+        }
+
+        TermEvent event;
+        event.channel = channel;
+        event.time = time;
+
+        const size_t equal = part.find('=');
+        if (equal != std::string_view::npos)
+        {
+            const std::string_view value = trim(part.substr(equal + 1));
+            event.name = std::string(trim(part.substr(0, equal)));
+
+            if (parseNumber(value, event.value) == true)
+            {
+                event.type = TermEvent::Type::MEASURED_VALUE;
+            }
+            else
+            {
+                event.type = TermEvent::Type::STATE_CHANGE;
+                event.text = std::string(value);
+            }
+        }
+        else
+        {
+            event.type = TermEvent::Type::MESSAGE;
+            event.text = std::string(part);
+        }
+
+        events.push_back(std::move(event));
+    }
+}
+
+TermEventStream::TermEventStream(ZenniumConnection* const connection, size_t capacity) :
+    connection(connection),
+    events(capacity),
+    nextSubscriberId(1)
+{
+    this->connection->setTelegramObserver([this](int channel, const std::vector<uint8_t>& payload) {
+        return this->onTelegram(channel, payload);
+    });
+}
+
+TermEventStream::~TermEventStream()
+{
+    this->connection->setTelegramObserver(nullptr);
+}
+
+uint64_t TermEventStream::subscribe(Subscriber subscriber)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    const uint64_t id = this->nextSubscriberId++;
+    this->subscribers.emplace(id, std::move(subscriber));
+    return id;
+}
+
+void TermEventStream::unsubscribe(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    this->subscribers.erase(id);
+}
+
+bool TermEventStream::pop(TermEvent& event)
+{
+    return this->events.pop(event);
+}
+
+size_t TermEventStream::drain(std::vector<TermEvent>& events)
+{
+    return this->events.drain(events);
+}
+
+unsigned long TermEventStream::getDroppedEvents() const
+{
+    return this->events.getDropped();
+}
+
+bool TermEventStream::onTelegram(int channel, const std::vector<uint8_t>& payload)
+{
+    /*
+     * Replies on the control channel, e.g. to the deregistration in ZenniumConnection::disconnectFromTerm,
+     * are left to the queue of the connection, otherwise the waiting request would never get its reply.
+     */
+    if (channel == controlChannel)
+    {
+        return false;
+    }
+
+    /*
+     * Only called from the receiving thread of the connection, so the decode buffer needs no lock.
+     */
+    this->decoded.clear();
+    TermEventDecoder::decode(channel, payload, std::chrono::steady_clock::now(), this->decoded);
+
+    {
+        std::lock_guard<std::mutex> lock(this->subscriberMutex);
+        for (const auto& event : this->decoded)
+        {
+            for (const auto& [id, subscriber] : this->subscribers)
+            {
+                subscriber(event);
+            }
+        }
+    }
+
+    for (auto& event : this->decoded)
+    {
+        this->events.push(std::move(event));
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TERMEVENTSTREAM_H
+#define TERMEVENTSTREAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ringbuffer.h"
+
+class ZenniumConnection;
+
+/** Event decoded from a telegram of a Watch or Logging connection. */
+class TermEvent
+{
+public:
+    enum class Type
+    {
+        MEASURED_VALUE,     /**< A numeric value, name and value are set. */
+        STATE_CHANGE,       /**< A non numeric assignment, name and text are set. */
+        MESSAGE,            /**< A text without assignment, text is set. */
+        RAW                 /**< A binary telegram, raw is set. */
+    };
+
+    Type type = Type::MESSAGE;
+    int channel = 0;                                /**< Channel (message type) of the telegram. */
+    std::chrono::steady_clock::time_point time;     /**< Time when the telegram was received. */
+    std::string name;                               /**< Name of the value or state. */
+    double value = 0.0;                             /**< Measured value. */
+    std::string text;                               /**< Text of the state or message. */
+    std::vector<uint8_t> raw;                       /**< Payload of a binary telegram. */
+};
+
+/** The TermEventDecoder class
+ *
+ *  Decodes the telegrams of Watch and Logging connections into TermEvents.
+ *
+ *  Text telegrams are split at ";" and line breaks. Parts like "Pot=1.2e-3" become measured values,
+ *  assignments with non numeric values become state changes and other text becomes a message.
+ *  Telegrams which are not printable text are passed on as raw events, so no information is lost.
+ */
+class TermEventDecoder
+{
+public:
+    /** Decode a telegram.
+     *
+     * \param  channel The channel of the telegram.
+     * \param  payload The payload of the telegram.
+     * \param  time The receive time.
+     * \param  events The decoded events are appended to this vector.
+     */
+    static void decode(int channel, const std::vector<uint8_t>& payload, std::chrono::steady_clock::time_point time, std::vector<TermEvent>& events);
+};
+
+/** The TermEventStream class
+ *
+ *  Passive observation of a running measurement through a connection in Watch or Logging mode.
+ *
+ *  The stream installs itself as telegram observer of the connection, decodes all incoming telegrams and
+ *  stores the events in a ring buffer. Subscribers are additionally called for each event. Nothing is sent
+ *  to the workstation, so the script channel of the measurement is not disturbed.
+ *
+ *  The connection must be connected with the connection name "Watch" or "Logging" and must not be used
+ *  for Remote Script commands, because all telegrams except the replies on the control channel 128 are
+ *  consumed by the stream.
+ */
+class TermEventStream
+{
+public:
+    typedef std::function<void(const TermEvent&)> Subscriber;
+
+    /** Constructor.
+     *
+     * \param  connection The connection in Watch or Logging mode.
+     * \param  capacity The number of events the ring buffer can hold.
+     */
+    TermEventStream(ZenniumConnection* const connection, size_t capacity = 4096);
+
+    /** The destructor removes the observer from the connection. */
+    ~TermEventStream();
+
+    TermEventStream(const TermEventStream &) = delete;
+    TermEventStream& operator=(const TermEventStream &) = delete;
+
+    /** Add a subscriber which is called in the receiving thread for each event.
+     *
+     * \param  subscriber The function.
+     *
+     * \return The id of the subscription.
+     */
+    uint64_t subscribe(Subscriber subscriber);
+
+    /** Remove a subscriber.
+     *
+     * \param  id The id of the subscription.
+     */
+    void unsubscribe(uint64_t id);
+
+    /** Remove the oldest event from the buffer.
+     *
+     * \param  event Receives the event.
+     *
+     * \return false if no event was available.
+     */
+    bool pop(TermEvent& event);
+
+    /** Move all buffered events into a vector.
+     *
+     * \param  events The events are appended to this vector.
+     *
+     * \return The number of events.
+     */
+    size_t drain(std::vector<TermEvent>& events);
+
+    /** Get the number of events which were overwritten before they were read.
+     *
+     * \return The number of dropped events.
+     */
+    unsigned long getDroppedEvents() const;
+
+private:
+    /** Observer which is called by the connection for each telegram. */
+    bool onTelegram(int channel, const std::vector<uint8_t>& payload);
+
+    ZenniumConnection* const connection;
+    RingBuffer<TermEvent> events;
+
+    std::mutex subscriberMutex;
+    std::map<uint64_t, Subscriber> subscribers;
+    uint64_t nextSubscriberId;
+
+    std::vector<TermEvent> decoded;
+};
+
+#endif // TERMEVENTSTREAM_H
@@ -24,31 +24,64 @@
  * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "thalesfileinterface.h"
+#include "receivedfilestore.h"
+#include "sha256.h"
+#include "termconnectionerror.h"
 #include <iostream>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <regex>
+#include <exception>
 
 ThalesFileInterface::ThalesFileInterface(std::string address, std::string connectionName)
 {
     this->connectionName = connectionName;
     this->remoteConnection = new ZenniumConnection();
     this->remoteConnection->connectToTerm(address, connectionName);
-    this->filesToSkip.push_back("lastshot.ism");
+    this->filesToSkip.insert("lastshot.ism");
     this->saveReceivedFilesToDisk = false;
     this->keepReceivedFilesInObject = false;
     this->receiving_worker_is_running = false;
+    this->receivedFileSink = nullptr;
+    this->receivedFiles = std::make_unique<ReceivedFileStore>();
+    this->nextSubscriberId = 1;
+    this->fileReceivedCallbackId = 0;
+    this->chunkSubscribers = 0;
+    this->receivingWorker = nullptr;
+    this->receiving_worker_is_finished = true;
+    this->stopDeadline = std::chrono::milliseconds(5000);
+    this->hashReceivedFiles = false;
+    this->duplicateFiles = 0;
+    this->staleBytes = 0;
+    this->staleLengthPending = false;
 }
 
 ThalesFileInterface::ThalesFileInterface(ZenniumConnection* connection)
 {
     this->connectionName = connection->getConnectionName();
     this->remoteConnection = connection;
-    this->filesToSkip.push_back("lastshot.ism");
+    this->filesToSkip.insert("lastshot.ism");
     this->saveReceivedFilesToDisk = false;
     this->keepReceivedFilesInObject = false;
     this->receiving_worker_is_running = false;
+    this->receivedFileSink = nullptr;
+    this->receivedFiles = std::make_unique<ReceivedFileStore>();
+    this->nextSubscriberId = 1;
+    this->fileReceivedCallbackId = 0;
+    this->chunkSubscribers = 0;
+    this->receivingWorker = nullptr;
+    this->receiving_worker_is_finished = true;
+    this->stopDeadline = std::chrono::milliseconds(5000);
+    this->hashReceivedFiles = false;
+    this->duplicateFiles = 0;
+    this->staleBytes = 0;
+    this->staleLengthPending = false;
+}
+
+ThalesFileInterface::~ThalesFileInterface()
+{
+
 }
 
 void ThalesFileInterface::close()
@@ -63,6 +96,7 @@ void ThalesFileInterface::close()
 std::string ThalesFileInterface::enableAutomaticFileExchange(bool enable, std::string fileExtensions)
 {
     std::string retval;
+    const auto start = std::chrono::steady_clock::now();
     if(enable == true)
     {
         retval = this->remoteConnection->sendStringAndWaitForReplyString(
@@ -72,6 +106,9 @@ std::string ThalesFileInterface::enableAutomaticFileExchange(bool enable, std::s
                     132
                     );
         this->startWorker();
+
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        this->exchangeStatistics.lastStartLatency = std::chrono::steady_clock::now() - start;
     }
     else
     {
@@ -81,9 +118,10 @@ std::string ThalesFileInterface::enableAutomaticFileExchange(bool enable, std::s
                     std::chrono::duration<int, std::milli>::max(),
                     132
                     );
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
         this->stoppWorker();
 
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        this->exchangeStatistics.lastStopLatency = std::chrono::steady_clock::now() - start;
     }
     return retval;
 }
@@ -93,23 +131,228 @@ std::string ThalesFileInterface::disableAutomaticFileExchange()
     return this->enableAutomaticFileExchange(false);
 }
 
+void ThalesFileInterface::setStopDeadline(std::chrono::milliseconds deadline)
+{
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->stopDeadline = deadline;
+}
+
+ThalesFileInterface::ExchangeStatistics ThalesFileInterface::getExchangeStatistics() const
+{
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    return this->exchangeStatistics;
+}
+
 ThalesFileInterface::FileObject ThalesFileInterface::acquireFile(std::string filename)
 {
     FileObject retval;
     retval.name = "";
     if(receiving_worker_is_running == false)
     {
-        this->remoteConnection->sendTelegram(
-                    "3," + this->connectionName + ",1," + filename,
-                    128);
+        this->requestFile(filename);
         retval = this->receiveFile(std::chrono::duration<int, std::milli>::max());
     }
     return retval;
 }
 
+ThalesFileInterface::FileObject ThalesFileInterface::acquireFile(std::string filename, ReceivedFileSink& sink)
+{
+    FileObject retval;
+    retval.name = "";
+    if(receiving_worker_is_running == false)
+    {
+        this->requestFile(filename);
+        retval = this->receiveFile(std::chrono::duration<int, std::milli>::max(), &sink);
+    }
+    return retval;
+}
+
+/** Sink which sends the request for the next file before the previous file is finished by the actual sink. */
+class PipelinedFileSink : public ReceivedFileSink
+{
+public:
+    PipelinedFileSink(ReceivedFileSink& sink) :
+        sink(sink)
+    {
+
+    }
+
+    void begin(const std::string& name, const std::string& path, size_t length) override
+    {
+        this->sink.begin(name, path, length);
+    }
+
+    void write(const uint8_t* data, size_t size) override
+    {
+        this->sink.write(data, size);
+    }
+
+    void end(bool complete) override
+    {
+        this->finished = std::chrono::steady_clock::now();
+        if(complete == true && this->requestNext)
+        {
+            this->requestNext();
+            this->requestNext = nullptr;
+        }
+        this->sink.end(complete);
+    }
+
+    ReceivedFileSink& sink;
+    std::function<void()> requestNext;
+    std::chrono::steady_clock::time_point finished;
+};
+
+ThalesFileInterface::BatchResult ThalesFileInterface::acquireFiles(const std::vector<std::string>& filenames, ReceivedFileSink& sink,
+                                                                   std::function<void(const FileTransfer&)> progressCallback)
+{
+    BatchResult retval;
+    if(receiving_worker_is_running == true || filenames.empty() == true)
+    {
+        return retval;
+    }
+
+    const auto batchStart = std::chrono::steady_clock::now();
+    retval.files.reserve(filenames.size());
+
+    PipelinedFileSink pipelinedSink(sink);
+    std::chrono::steady_clock::time_point requested = std::chrono::steady_clock::now();
+    this->requestFile(filenames.front());
+
+    for(size_t i = 0; i < filenames.size(); i++)
+    {
+        std::chrono::steady_clock::time_point nextRequested;
+        bool nextSent = false;
+        if(i + 1 < filenames.size())
+        {
+            pipelinedSink.requestNext = [this, &filenames, i, &nextRequested, &nextSent]() {
+                nextRequested = std::chrono::steady_clock::now();
+                this->requestFile(filenames[i + 1]);
+                nextSent = true;
+            };
+        }
+
+        pipelinedSink.finished = {};
+        FileTransfer transfer;
+        transfer.filename = filenames[i];
+        transfer.requested = requested;
+
+        /*
+         * An error of the sink ends only this file: receiveFile has already read all chunks of the file and
+         * the request for the next file may already be sent, so the batch continues with the next file.
+         * Errors of the connection abort the batch, because the replies can no longer be assigned.
+         */
+        try {
+            auto file = this->receiveFile(std::chrono::duration<int, std::milli>::max(), &pipelinedSink);
+            transfer.name = file.name;
+            transfer.size = file.size;
+        }  catch (const TermConnectionError&) {
+            throw;
+        }  catch (const std::exception& e) {
+            transfer.error = e.what();
+            if(transfer.error.empty() == true)
+            {
+                transfer.error = "Unknown error.";
+            }
+        }
+        transfer.finished = pipelinedSink.finished != std::chrono::steady_clock::time_point{} ? pipelinedSink.finished : std::chrono::steady_clock::now();
+
+        /*
+         * Files which do not exist, are skipped or failed before their end may not have sent the next request,
+         * so it is sent here.
+         */
+        pipelinedSink.requestNext = nullptr;
+        if(i + 1 < filenames.size() && nextSent == false)
+        {
+            nextRequested = std::chrono::steady_clock::now();
+            this->requestFile(filenames[i + 1]);
+        }
+        requested = nextRequested;
+
+        if(transfer.error.empty() == false)
+        {
+            retval.failedFiles++;
+        }
+        else if(transfer.name.empty() == true)
+        {
+            retval.missingFiles++;
+        }
+        retval.totalBytes += transfer.size;
+        retval.files.push_back(transfer);
+
+        if(progressCallback)
+        {
+            progressCallback(retval.files.back());
+        }
+    }
+
+    retval.duration = std::chrono::steady_clock::now() - batchStart;
+    return retval;
+}
+
+std::chrono::duration<double> ThalesFileInterface::FileTransfer::getDuration() const
+{
+    return this->finished - this->requested;
+}
+
+double ThalesFileInterface::FileTransfer::getThroughput() const
+{
+    const double seconds = this->getDuration().count();
+    return seconds > 0.0 ? static_cast<double>(this->size) / seconds : 0.0;
+}
+
+double ThalesFileInterface::BatchResult::getThroughput() const
+{
+    const double seconds = this->duration.count();
+    return seconds > 0.0 ? static_cast<double>(this->totalBytes) / seconds : 0.0;
+}
+
+void ThalesFileInterface::requestFile(const std::string& filename)
+{
+    this->remoteConnection->sendTelegram(
+                "3," + this->connectionName + ",1," + filename,
+                128);
+}
+
+void ThalesFileInterface::setReceivedFileSink(ReceivedFileSink* sink)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    this->receivedFileSink = sink;
+}
+
 void ThalesFileInterface::appendFilesToSkip(std::string filename)
 {
-    this->filesToSkip.push_back(filename);
+    std::lock_guard<std::mutex> lock(this->skipMutex);
+    if(filename.find_first_of("*?") != std::string::npos)
+    {
+        this->filePatternsToSkip.push_back(filename);
+    }
+    else
+    {
+        this->filesToSkip.insert(filename);
+    }
+}
+
+void ThalesFileInterface::enableDeduplication(std::filesystem::path indexFile, bool enable)
+{
+    std::shared_ptr<ReceivedFileIndex> index;
+    if(enable == true)
+    {
+        index = std::make_shared<ReceivedFileIndex>(indexFile);
+    }
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->fileIndex = index;
+    this->hashReceivedFiles = enable;
+}
+
+void ThalesFileInterface::disableDeduplication()
+{
+    this->enableDeduplication({}, false);
+}
+
+unsigned long ThalesFileInterface::getDuplicateFiles() const
+{
+    return this->duplicateFiles;
 }
 
 void ThalesFileInterface::setSavePath(std::string path)
@@ -128,6 +371,16 @@ void ThalesFileInterface::disableSaveReceivedFilesToDisk()
     this->saveReceivedFilesToDisk = false;
 }
 
+void ThalesFileInterface::enableSyncReceivedFilesToDisk(bool enable)
+{
+    this->fileWriter.enableSyncToDisk(enable);
+}
+
+FileWriteBehind::Statistics ThalesFileInterface::getSaveStatistics() const
+{
+    return this->fileWriter.getStatistics();
+}
+
 void ThalesFileInterface::enableKeepReceivedFilesInObject(bool enable)
 {
     keepReceivedFilesInObject = enable;
@@ -138,14 +391,19 @@ void ThalesFileInterface::disableKeepReceivedFilesInObject()
     this->enableKeepReceivedFilesInObject(false);
 }
 
-const std::vector<ThalesFileInterface::FileObject>& ThalesFileInterface::getReceivedFiles()
+std::vector<std::shared_ptr<const ThalesFileInterface::FileObject>> ThalesFileInterface::getReceivedFiles()
 {
-    return receivedFiles;
+    return this->receivedFiles->snapshot();
 }
 
-const ThalesFileInterface::FileObject &ThalesFileInterface::getLatestReceivedFile()
+std::shared_ptr<const ThalesFileInterface::FileObject> ThalesFileInterface::getLatestReceivedFile()
 {
-    return receivedFiles.back();
+    return this->receivedFiles->getLatest();
+}
+
+ReceivedFileStore& ThalesFileInterface::getReceivedFileStore()
+{
+    return *this->receivedFiles;
 }
 
 void ThalesFileInterface::saveReceivedFile(FileObject file)
@@ -156,57 +414,449 @@ void ThalesFileInterface::saveReceivedFile(FileObject file)
         std::filesystem::path fileName(file.name);
         std::filesystem::path fileNameWithPath = dir / fileName;
 
-        std::ofstream fileStream(fileNameWithPath,std::ofstream::binary);
-        for(auto data : file.binary_data)
+        FileWriteBehind::writeFile(fileNameWithPath, file.binary_data.data(), file.binary_data.size(), false);
+    }
+}
+
+void ThalesFileInterface::deleteReceivedFiles()
+{
+    this->receivedFiles->clear();
+}
+
+void ThalesFileInterface::setFileReceivedCallback(std::function<void(const FileObject&)> callback)
+{
+    if(this->fileReceivedCallbackId != 0)
+    {
+        this->unsubscribe(this->fileReceivedCallbackId);
+        this->fileReceivedCallbackId = 0;
+    }
+    if(callback)
+    {
+        this->fileReceivedCallbackId = this->subscribe([callback = std::move(callback)](const FileEvent& event) {
+            if(event.file != nullptr)
+            {
+                callback(*event.file);
+            }
+            else
+            {
+                FileObject file;
+                file.name = event.name;
+                file.path = event.path;
+                file.size = event.size;
+                callback(file);
+            }
+        });
+    }
+}
+
+uint64_t ThalesFileInterface::subscribe(FileEventCallback callback, ChunkCallback chunkCallback)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    const uint64_t id = this->nextSubscriberId++;
+    if(chunkCallback)
+    {
+        this->chunkSubscribers++;
+    }
+    this->subscribers.emplace(id, Subscription{std::move(callback), std::move(chunkCallback)});
+    return id;
+}
+
+void ThalesFileInterface::unsubscribe(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    auto subscription = this->subscribers.find(id);
+    if(subscription != this->subscribers.end())
+    {
+        if(subscription->second.chunkCallback)
         {
-            fileStream << data;
+            this->chunkSubscribers--;
         }
-        fileStream.close();
+        this->subscribers.erase(subscription);
     }
 }
 
-void ThalesFileInterface::deleteReceivedFiles()
+std::chrono::duration<double> ThalesFileInterface::FileEvent::getDuration() const
 {
-    this->receivedFiles.clear();
+    return this->finished - this->started;
 }
 
-ThalesFileInterface::FileObject ThalesFileInterface::receiveFile(const std::chrono::duration<int, std::milli> timeout)
+double ThalesFileInterface::FileEvent::getThroughput() const
+{
+    const double seconds = this->getDuration().count();
+    return seconds > 0.0 ? static_cast<double>(this->size) / seconds : 0.0;
+}
+
+ThalesFileInterface::FileObject ThalesFileInterface::receiveFile(const std::chrono::duration<int, std::milli> timeout, ReceivedFileSink* sink, FileEvent* event)
 {
     FileObject retval;
     retval.name = "";
     std::string filePath;
 
+    this->discardStaleTelegrams();
+
     try {
         filePath = this->remoteConnection->waitForStringTelegram(130,timeout);
     }  catch (...) {
         return retval;
     }
+    const auto started = std::chrono::steady_clock::now();
+
+    /*
+     * The sink of the automatic file exchange is only taken once a file is announced, and it stays locked
+     * until the file is finished. setReceivedFileSink therefore never replaces a sink which is still in use.
+     */
+    std::unique_lock<std::mutex> sinkLock;
+    if(event != nullptr)
+    {
+        sinkLock = std::unique_lock<std::mutex>(this->sinkMutex);
+        sink = this->receivedFileSink;
+    }
 
-    std::string fileLength = this->remoteConnection->waitForStringTelegram(129);
+    std::string fileLength;
+    try {
+        fileLength = this->remoteConnection->waitForStringTelegram(129);
+    }  catch (...) {
+        this->staleLengthPending = true;
+        throw;
+    }
     std::stringstream converterStream(fileLength);
-    int fileLengthBytes;
+    long long fileLengthBytes = 0;
     converterStream >> fileLengthBytes;
 
-    int bytesToReceive = fileLengthBytes;
+    retval.path = filePath;
+    retval.name = std::filesystem::path(filePath).filename().string();
+    retval.size = fileLengthBytes > 0 ? static_cast<size_t>(fileLengthBytes) : 0;
+
+    long long bytesToReceive = fileLengthBytes;
+
+    /*
+     * Skipped files of the automatic file exchange are received and discarded without being passed on. A file
+     * which was requested explicitly is always delivered. If the file does not exist, the reply has no name
+     * and the sink is not called.
+     */
+    const bool discard = retval.name.empty() == true || (event != nullptr && this->isFileToSkip(retval.name));
+    const bool notifyChunks = event != nullptr && discard == false && this->chunkSubscribers > 0;
+    const bool computeHash = event != nullptr && discard == false && this->hashReceivedFiles == true;
+    Sha256 hasher;
+    bool duplicate = false;
+    size_t offset = 0;
 
-    std::vector<uint8_t> fileData;
-    while(bytesToReceive > 0)
+    if(sink == nullptr)
     {
-        auto readBytes = this->remoteConnection->waitForTelegram(131);
-        fileData.insert(fileData.end(),readBytes.begin(),readBytes.end());
-        bytesToReceive -= readBytes.size();
+        /*
+         * The announced length is reserved in advance, so the data is not reallocated while it grows.
+         */
+        retval.binary_data.reserve(retval.size);
+        try {
+            while(bytesToReceive > 0)
+            {
+                auto readBytes = this->remoteConnection->waitForTelegram(131);
+                bytesToReceive -= readBytes.size();
+                if(notifyChunks == true)
+                {
+                    this->notifyChunk(retval.name, readBytes.data(), readBytes.size(), offset);
+                }
+                if(computeHash == true)
+                {
+                    hasher.update(readBytes.data(), readBytes.size());
+                }
+                offset += readBytes.size();
+                retval.binary_data.insert(retval.binary_data.end(),readBytes.begin(),readBytes.end());
+            }
+        }  catch (...) {
+            this->staleBytes = bytesToReceive;
+            throw;
+        }
+
+        if(computeHash == true)
+        {
+            retval.sha256 = Sha256::toHex(hasher.finish());
+            duplicate = this->isDuplicateFile(retval);
+        }
     }
+    else
+    {
+        /*
+         * Streaming mode: each chunk is passed on as it arrives.
+         *
+         * If the sink fails, the remaining chunks of the file are still read and discarded before the error is
+         * rethrown. Otherwise they would stay in the queue and be taken as the beginning of the next file.
+         */
+        bool sinkActive = false;
+        std::exception_ptr sinkError;
+        if(discard == false)
+        {
+            try {
+                sink->begin(retval.name, retval.path, retval.size);
+                sinkActive = true;
+            }  catch (...) {
+                sinkError = std::current_exception();
+            }
+        }
+        try {
+            while(bytesToReceive > 0)
+            {
+                auto readBytes = this->remoteConnection->waitForTelegram(131);
+                bytesToReceive -= readBytes.size();
+                if(sinkError != nullptr)
+                {
+                    continue;
+                }
+                if(sinkActive == true)
+                {
+                    try {
+                        sink->write(readBytes.data(), readBytes.size());
+                    }  catch (...) {
+                        sinkError = std::current_exception();
+                        continue;
+                    }
+                }
+                if(notifyChunks == true)
+                {
+                    this->notifyChunk(retval.name, readBytes.data(), readBytes.size(), offset);
+                }
+                if(computeHash == true)
+                {
+                    hasher.update(readBytes.data(), readBytes.size());
+                }
+                offset += readBytes.size();
+            }
+        }  catch (...) {
+            this->staleBytes = bytesToReceive;
+            if(sinkActive == true)
+            {
+                sink->end(false);
+            }
+            throw;
+        }
+        if(sinkError != nullptr)
+        {
+            if(sinkActive == true)
+            {
+                sink->end(false);
+            }
+            std::rethrow_exception(sinkError);
+        }
+        if(computeHash == true)
+        {
+            retval.sha256 = Sha256::toHex(hasher.finish());
+            duplicate = this->isDuplicateFile(retval);
+        }
 
-    retval.binary_data = fileData;
-    retval.path = filePath;
-    retval.name = std::filesystem::path(filePath).filename().string();
+        /*
+         * The duplicate check is done before the sink commits the file, so a duplicate is dropped by the sink
+         * and identical content is stored only once. The content is added to the index only after the sink
+         * has committed it without an error.
+         */
+        if(sinkActive == true)
+        {
+            auto record = duplicate == false ? this->recordOnCommit(retval) : nullptr;
+            sink->end(duplicate == false);
+            if(record != nullptr)
+            {
+                record(true);
+            }
+        }
+    }
+
+    if(discard == true)
+    {
+        retval.name = "";
+    }
+    if(event != nullptr)
+    {
+        event->streamed = sink != nullptr;
+        event->duplicate = duplicate;
+        event->name = retval.name;
+        event->path = retval.path;
+        event->size = retval.size;
+        event->sha256 = retval.sha256;
+        event->started = started;
+        event->finished = std::chrono::steady_clock::now();
+    }
     return retval;
 }
 
+void ThalesFileInterface::discardStaleTelegrams()
+{
+    if(this->staleLengthPending == false && this->staleBytes <= 0)
+    {
+        return;
+    }
+
+    /*
+     * Term sends the rest of an aborted file anyway. If it does not arrive within the stop deadline, it is
+     * assumed that it never will. If the wait was interrupted instead, the rest is discarded by the next call.
+     */
+    std::chrono::milliseconds deadline;
+    {
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        deadline = this->stopDeadline;
+    }
+    const auto timeout = std::chrono::duration<int, std::milli>(static_cast<int>(std::min<std::chrono::milliseconds::rep>(
+        deadline.count(), std::chrono::duration<int, std::milli>::max().count())));
+    const auto start = std::chrono::steady_clock::now();
+
+    try {
+        if(this->staleLengthPending == true)
+        {
+            std::stringstream converterStream(this->remoteConnection->waitForStringTelegram(129, timeout));
+            long long fileLengthBytes = 0;
+            converterStream >> fileLengthBytes;
+            this->staleBytes = fileLengthBytes;
+            this->staleLengthPending = false;
+        }
+        while(this->staleBytes > 0)
+        {
+            this->staleBytes -= static_cast<long long>(this->remoteConnection->waitForTelegram(131, timeout).size());
+        }
+    }  catch (...) {
+        if(std::chrono::steady_clock::now() - start >= timeout)
+        {
+            this->staleLengthPending = false;
+            this->staleBytes = 0;
+        }
+        else
+        {
+            throw;
+        }
+    }
+}
+
+bool ThalesFileInterface::isDuplicateFile(const FileObject& file)
+{
+    std::shared_ptr<ReceivedFileIndex> index;
+    {
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        index = this->fileIndex;
+    }
+    ReceivedFileIndex::Entry entry;
+    if(index != nullptr && index->find(file.sha256, entry) == true)
+    {
+        this->duplicateFiles++;
+        return true;
+    }
+    return false;
+}
+
+std::function<void(bool)> ThalesFileInterface::recordOnCommit(const FileObject& file)
+{
+    std::shared_ptr<ReceivedFileIndex> index;
+    {
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        index = this->fileIndex;
+    }
+    if(index == nullptr || file.sha256.empty() == true)
+    {
+        return nullptr;
+    }
+
+    /*
+     * The index is captured here, so the entry goes into the index which was used for the duplicate check,
+     * even if the deduplication is changed while the file is still being written.
+     */
+    return [index, hash = file.sha256, size = file.size, name = file.name](bool committed) {
+        if(committed == true)
+        {
+            index->insert(hash, size, name);
+        }
+    };
+}
+
+void ThalesFileInterface::notifyFileEvent(const FileEvent& event)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    for(const auto& [id, subscription] : this->subscribers)
+    {
+        if(subscription.callback)
+        {
+            subscription.callback(event);
+        }
+    }
+}
+
+void ThalesFileInterface::notifyChunk(const std::string& name, const uint8_t* data, size_t size, size_t offset)
+{
+    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+    for(const auto& [id, subscription] : this->subscribers)
+    {
+        if(subscription.chunkCallback)
+        {
+            subscription.chunkCallback(name, data, size, offset);
+        }
+    }
+}
+
+/** Match a filename against a pattern with the wildcards * and ?. */
+static bool matchesPattern(const std::string& pattern, const std::string& name)
+{
+    size_t p = 0;
+    size_t n = 0;
+    size_t starPattern = std::string::npos;
+    size_t starName = 0;
+
+    while(n < name.size())
+    {
+        if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+        {
+            p++;
+            n++;
+        }
+        else if(p < pattern.size() && pattern[p] == '*')
+        {
+            starPattern = p++;
+            starName = n;
+        }
+        else if(starPattern != std::string::npos)
+        {
+            p = starPattern + 1;
+            n = ++starName;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while(p < pattern.size() && pattern[p] == '*')
+    {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+bool ThalesFileInterface::isFileToSkip(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(this->skipMutex);
+    if(this->filesToSkip.count(name) > 0)
+    {
+        return true;
+    }
+    for(const auto& pattern : this->filePatternsToSkip)
+    {
+        if(matchesPattern(pattern, name) == true)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ThalesFileInterface::startWorker()
 {
     if(this->receiving_worker_is_running == false)
     {
+        if(this->receivingWorker != nullptr)
+        {
+            /*
+             * The previous thread was terminated by an error.
+             */
+            this->receivingWorker->join();
+            delete this->receivingWorker;
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->workerMutex);
+            this->receiving_worker_is_finished = false;
+        }
         this->receiving_worker_is_running = true;
         this->receivingWorker = new std::thread(&ThalesFileInterface::fileReceiverJob, this);
     }
@@ -217,33 +867,93 @@ void ThalesFileInterface::stoppWorker()
     if(this->receiving_worker_is_running == true)
     {
         this->receiving_worker_is_running = false;
+
+        /*
+         * Term has answered the OFF command, so all files which were sent before are already announced.
+         * The waiting for the next announcement is interrupted at once, announced files are still received.
+         */
+        this->remoteConnection->setWaitInterrupted(130, true);
+
+        std::unique_lock<std::mutex> lock(this->workerMutex);
+        const bool finished = this->workerFinished.wait_for(lock, this->stopDeadline, [this]() {
+            return this->receiving_worker_is_finished;
+        });
+        if(finished == false)
+        {
+            this->exchangeStatistics.interruptedTransfers++;
+            this->remoteConnection->setWaitInterrupted(129, true);
+            this->remoteConnection->setWaitInterrupted(131, true);
+        }
+        lock.unlock();
+
         this->receivingWorker->join();
         delete this->receivingWorker;
+        this->receivingWorker = nullptr;
+
+        this->remoteConnection->setWaitInterrupted(129, false);
+        this->remoteConnection->setWaitInterrupted(130, false);
+        this->remoteConnection->setWaitInterrupted(131, false);
+        this->fileWriter.flush();
     }
 }
 
 void ThalesFileInterface::fileReceiverJob()
 {
-    while (this->receiving_worker_is_running == true)
+    while (this->receiving_worker_is_running == true || this->remoteConnection->isTelegramAvailable(130) == true)
     {
         try {
-            auto file = this->receiveFile(std::chrono::milliseconds(1000));
-            if(file.name != "")
+            FileEvent event;
+            auto file = this->receiveFile(std::chrono::duration<int, std::milli>::max(), nullptr, &event);
+
+            if(file.name != "" && (event.streamed == true || event.duplicate == true))
+            {
+                this->notifyFileEvent(event);
+            }
+            else if(file.name != "")
             {
-                if(std::find(filesToSkip.begin(),filesToSkip.end(),file.name) == filesToSkip.end())
+                bool hasSubscribers;
+                {
+                    std::lock_guard<std::mutex> lock(this->subscriberMutex);
+                    hasSubscribers = this->subscribers.empty() == false;
+                }
+                const bool share = keepReceivedFilesInObject == true || hasSubscribers == true;
+
+                if(saveReceivedFilesToDisk == true)
                 {
-                    if(saveReceivedFilesToDisk == true)
+                    /*
+                     * The file is written behind by the writer thread, so the receiving thread can
+                     * continue to drain the channels. The data is only copied if it is still needed.
+                     */
+                    std::filesystem::path fileNameWithPath = std::filesystem::path(this->pathToSave) / std::filesystem::path(file.name);
+                    auto record = this->recordOnCommit(file);
+                    if(share == true)
                     {
-                        this->saveReceivedFile(file);
+                        this->fileWriter.enqueue(fileNameWithPath, file.binary_data, std::move(record));
                     }
+                    else
+                    {
+                        this->fileWriter.enqueue(fileNameWithPath, std::move(file.binary_data), std::move(record));
+                    }
+                }
+                if(share == true)
+                {
+                    event.file = std::make_shared<const FileObject>(std::move(file));
                     if(keepReceivedFilesInObject == true)
                     {
-                        this->receivedFiles.push_back(file);
+                        this->receivedFiles->put(event.file);
                     }
+                    this->notifyFileEvent(event);
                 }
             }
         }  catch (...) {
             this->receiving_worker_is_running = false;
+            break;
         }
     }
+
+    {
+        std::lock_guard<std::mutex> lock(this->workerMutex);
+        this->receiving_worker_is_finished = true;
+    }
+    this->workerFinished.notify_all();
 }
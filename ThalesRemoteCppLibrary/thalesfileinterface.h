@@ -26,9 +26,23 @@
 #ifndef THALESFILEINTERFACE_H
 #define THALESFILEINTERFACE_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include "thalesremoteconnection.h"
+#include "receivedfilesink.h"
+#include "filewritebehind.h"
+#include "receivedfileindex.h"
+
+class ReceivedFileStore;
 
 /** The ThalesFileInterface class
  *
@@ -51,8 +65,86 @@ public:
         std::string name;                   /**< Filename without path. */
         std::string path;                   /**< Filename with path on the Thales computer. */
         std::vector<uint8_t> binary_data;   /**< Data as bytearray. */
+        size_t size = 0;                    /**< Size of the file in bytes, also set if the data was streamed to a sink. */
+        std::string sha256;                 /**< Hexadecimal SHA-256 of the data if deduplication is enabled. */
+    };
+
+    class FileEvent
+    {
+    public:
+        std::string name;                   /**< Filename without path. */
+        std::string path;                   /**< Filename with path on the Thales computer. */
+        size_t size = 0;                    /**< Size of the file in bytes. */
+        std::string sha256;                 /**< Hexadecimal SHA-256 of the data if deduplication is enabled. */
+        bool duplicate = false;             /**< true if the same content was received before, the file is then not stored again. */
+        bool streamed = false;              /**< true if the data was streamed to the sink of the automatic file exchange. */
+        std::chrono::steady_clock::time_point started;  /**< Time when the transfer of the file started. */
+        std::chrono::steady_clock::time_point finished; /**< Time when the last chunk was received. */
+        std::shared_ptr<const FileObject> file; /**< The file with data, or nullptr if the data was streamed to a sink. */
+
+        /** Get the duration of the transfer.
+         *
+         * @return The duration in seconds.
+         */
+        std::chrono::duration<double> getDuration() const;
+
+        /** Get the throughput of the transfer.
+         *
+         * @return The throughput in bytes per second.
+         */
+        double getThroughput() const;
+    };
+
+    class FileTransfer
+    {
+    public:
+        std::string filename;               /**< The requested filename with path. */
+        std::string name;                   /**< Filename without path, empty if the file does not exist or failed. */
+        size_t size = 0;                    /**< Size of the file in bytes. */
+        std::string error;                  /**< Error of the sink, empty if the file was transferred. */
+        std::chrono::steady_clock::time_point requested; /**< Time when the file was requested. */
+        std::chrono::steady_clock::time_point finished;  /**< Time when the last chunk was received. */
+
+        /** Get the duration from the request to the last chunk.
+         *
+         * @return The duration in seconds.
+         */
+        std::chrono::duration<double> getDuration() const;
+
+        /** Get the throughput of the transfer.
+         *
+         * @return The throughput in bytes per second.
+         */
+        double getThroughput() const;
+    };
+
+    class BatchResult
+    {
+    public:
+        std::vector<FileTransfer> files;    /**< One entry per requested file in the order of the request. */
+        unsigned long long totalBytes = 0;  /**< Number of bytes of all files. */
+        unsigned long missingFiles = 0;     /**< Number of files which did not exist. */
+        unsigned long failedFiles = 0;      /**< Number of files which could not be written into the sink. */
+        std::chrono::duration<double> duration{0}; /**< Duration of the whole batch. */
+
+        /** Get the throughput of the whole batch.
+         *
+         * @return The throughput in bytes per second.
+         */
+        double getThroughput() const;
+    };
+
+    class ExchangeStatistics
+    {
+    public:
+        std::chrono::duration<double> lastStartLatency{0}; /**< Duration of the last enabling of the automatic file exchange. */
+        std::chrono::duration<double> lastStopLatency{0};  /**< Duration of the last disabling of the automatic file exchange. */
+        unsigned long interruptedTransfers = 0; /**< Transfers which were aborted because the stop deadline was reached. */
     };
 
+    typedef std::function<void(const FileEvent&)> FileEventCallback;
+    typedef std::function<void(const std::string& name, const uint8_t* data, size_t size, size_t offset)> ChunkCallback;
+
     /** Construct a new Thales File Interface object
      *
      * \param address The hostname or ip-address of the host running Term.
@@ -60,6 +152,7 @@ public:
      */
     ThalesFileInterface(std::string address = "localhost", std::string connectionName = "FileExchange");
     ThalesFileInterface(ZenniumConnection* connection);
+    ~ThalesFileInterface();
 
     /** Close the file interface.
     *
@@ -84,6 +177,24 @@ public:
      */
     std::string disableAutomaticFileExchange();
 
+    /** Set the maximum time to wait for files in transfer when the automatic file exchange is disabled.
+     *
+     * Files which Term has already started to send are received completely before the receiving thread
+     * stops. If this takes longer than the deadline, the transfer is aborted and the file is dropped. The
+     * rest of the aborted file, which Term still sends, is discarded before the next file is received by the
+     * automatic file exchange or acquireFile, so it cannot corrupt later files. If the rest does not arrive
+     * within the deadline either, it is no longer waited for.
+     *
+     * \param deadline The maximum time. Default 5 s.
+     */
+    void setStopDeadline(std::chrono::milliseconds deadline);
+
+    /** Get the start and stop latencies of the automatic file exchange.
+     *
+     * \return The statistics.
+     */
+    ExchangeStatistics getExchangeStatistics() const;
+
     /** Transfer a single file.
      *
      *  This command transfers a single from Term to Python.
@@ -98,14 +209,88 @@ public:
      */
     FileObject acquireFile(std::string filename);
 
+    /** Transfer a single file into a sink.
+     *
+     *  Like acquireFile, but the data is passed chunk by chunk to the sink as it arrives and is not
+     *  collected in memory. The returned file object contains no data. The list of files to skip does not
+     *  apply, the requested file is always passed to the sink.
+     *
+     * \param filename The full path of the file on the computer running the Thales software.
+     * \param sink The destination of the data.
+     * \return The file object without data.
+     */
+    FileObject acquireFile(std::string filename, ReceivedFileSink& sink);
+
+    /** Set a sink for the files of the automatic file exchange.
+     *
+     *  While a sink is set, the received files are streamed into it chunk by chunk. The data is then neither
+     *  saved to the hard disk nor kept in the object by this class, the file received callback receives the
+     *  file object without data. Skipped files are not passed to the sink.
+     *  The sink is taken when the next file is announced. If a file is being streamed into the previous sink,
+     *  this function waits until that file is finished, so the previous sink may be destroyed afterwards.
+     *  It must not be called from the sink or from a chunk callback.
+     *
+     * @param sink The sink or nullptr to collect the files in memory again.
+     */
+    void setReceivedFileSink(ReceivedFileSink* sink);
+
+    /** Transfer many files into a sink.
+     *
+     *  The requests are pipelined: the request for the next file is sent as soon as the last chunk of the
+     *  previous file was received, while the sink is still finishing the previous file. Like acquireFile,
+     *  this command can only be executed if automatic transfer is disabled, otherwise the result is empty.
+     *
+     *  If the sink throws for a file, the error is stored in its FileTransfer and the batch continues with
+     *  the next file. Only a TermConnectionError aborts the batch.
+     *
+     * \param filenames The full paths of the files on the computer running the Thales software.
+     * \param sink The destination of the data.
+     * \param progressCallback Optional function which is called after each file.
+     * \return The statistics per file and of the whole batch.
+     */
+    BatchResult acquireFiles(const std::vector<std::string>& filenames, ReceivedFileSink& sink,
+                             std::function<void(const FileTransfer&)> progressCallback = nullptr);
+
     /** Set filenames to be filtered and not processed by C++.
      *
      *  Files with these names are not saved to disk by C++ and do not remain in the object.
+     *  The name may contain the wildcards * and ?, e.g. "lastshot*.ism".
+     *  The list only applies to the automatic file exchange. Files requested with acquireFile or acquireFiles
+     *  are always delivered.
      *
-     * @param filename Filename to be filtered.
+     * @param filename Filename or pattern to be filtered.
      */
     void appendFilesToSkip(std::string filename);
 
+    /** Enable the deduplication of the files received by the automatic file exchange.
+     *
+     *  The SHA-256 of each file is calculated while its chunks arrive. Content which is already in the index
+     *  is reported as duplicate to the subscribers, but not saved to the hard disk and not kept in the object
+     *  again. For files which are streamed to a sink, the sink is finished with ReceivedFileSink::end(false), so
+     *  it drops the data.
+     *
+     *  Content is only added to the index once it is stored durably: when the sink returned from
+     *  ReceivedFileSink::end(true) without an error, or when the file was written to the hard disk. Files which
+     *  are only kept in the object or passed to the subscribers are not added, nor are files whose sink or write
+     *  failed, so a later copy of them is stored again. A copy arriving while the first one is still queued for
+     *  writing is not detected as duplicate either.
+     *
+     * @param indexFile File in which the index is kept across sessions, empty to keep it only in memory.
+     * @param enable true to enable the deduplication.
+     */
+    void enableDeduplication(std::filesystem::path indexFile = {}, bool enable = true);
+
+    /** Disable the deduplication.
+     *
+     */
+    void disableDeduplication();
+
+    /** Get the number of received files whose content was already in the index.
+     *
+     * @return The number of duplicates.
+     */
+    unsigned long getDuplicateFiles() const;
+
     /** Set the path where the files should be saved on the local computer.
      *
      *  This command sets only the path.
@@ -131,10 +316,26 @@ public:
      */
     void disableSaveReceivedFilesToDisk();
 
+    /** Enable that the saved files are synchronized to the disk.
+     *
+     *  The received files are written by a separate writer thread, so that the receiving thread is not blocked.
+     *  With this option each file is synchronized to the disk before it gets its final name.
+     *
+     * @param enable true = Synchronize the files to the disk.
+     */
+    void enableSyncReceivedFilesToDisk(bool enable = true);
+
+    /** Get the statistics of the writer thread which saves the received files.
+     *
+     * @return The statistics.
+     */
+    FileWriteBehind::Statistics getSaveStatistics() const;
+
     /** Enable that the files remain in the C++ object.
      *
      * If you perform many measurements, the C++ object would grow larger and larger due to the
-     * number of files, so you can disable that the files are stored in the object as an array.
+     * number of files, so you can disable that the files are stored in the object as an array,
+     * or limit the number of files and bytes with getReceivedFileStore().setLimits.
      * By default, the files remain in the object.
      *
      * @param enable true = Allow the files to remain in the object.
@@ -148,19 +349,30 @@ public:
 
     /** Read all received files from the object.
      *
-     * @return vector with the file objects.
+     *  The files are shared and not copied, they remain valid even if they are deleted from the object.
+     *
+     * @return vector with the file objects in the order of arrival.
      */
-    const std::vector<FileObject>& getReceivedFiles();
+    std::vector<std::shared_ptr<const FileObject>> getReceivedFiles();
 
     /** Read the latest received files from the object.
      *
-     * @return file object.
+     * @return file object or nullptr if no file was received.
      */
-    const FileObject& getLatestReceivedFile();
+    std::shared_ptr<const FileObject> getLatestReceivedFile();
+
+    /** Get the store in which the received files remain.
+     *
+     *  The store is thread-safe and can be limited in number of files and bytes.
+     *
+     * @return The store.
+     */
+    ReceivedFileStore& getReceivedFileStore();
 
     /** Writing a file object to the hard disk.
      *
      *  Writes the file object to the hard disk at the previously defined path.
+     *  The file is written with one call into a temporary file, which is then renamed.
      *
      * @param file The file object.
      */
@@ -171,11 +383,84 @@ public:
      */
     void deleteReceivedFiles();
 
+    /** Set a function which is called for each file received by the automatic file exchange.
+     *
+     *  The function is called in the receiving thread as soon as a file is complete, before it is saved
+     *  and independent of whether it remains in the object. Skipped files are not reported.
+     *
+     * @param callback The function, or an empty function to remove it.
+     */
+    void setFileReceivedCallback(std::function<void(const FileObject&)> callback);
+
+    /** Subscribe to the files received by the automatic file exchange.
+     *
+     *  The callback is called in the receiving thread with name, path, size and timing of each file as soon as
+     *  it is complete. If the file is collected in memory, the event also contains the data, which is shared and
+     *  not copied. If a chunk callback is given, each chunk is additionally passed on while it arrives, so the
+     *  data can be processed as a streaming body before the file is complete. Skipped files are not reported.
+     *
+     *  The callbacks must not subscribe or unsubscribe themselves.
+     *
+     * @param callback The function which is called for each file.
+     * @param chunkCallback Optional function which is called for each chunk.
+     * @return The id of the subscription.
+     */
+    uint64_t subscribe(FileEventCallback callback, ChunkCallback chunkCallback = nullptr);
+
+    /** Remove a subscription.
+     *
+     * @param id The id of the subscription.
+     */
+    void unsubscribe(uint64_t id);
+
 private:
+    class Subscription
+    {
+    public:
+        FileEventCallback callback;
+        ChunkCallback chunkCallback;
+    };
+
     /** Receive a file via the interface.
+     *
+     *  If event is set, the file belongs to the automatic file exchange. The sink argument is then ignored and
+     *  the sink set by setReceivedFileSink is used, which is locked until the file is finished.
+     */
+    FileObject receiveFile(const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max(),
+                           ReceivedFileSink* sink = nullptr,
+                           FileEvent* event = nullptr);
+
+    /** Call the file callbacks of all subscribers.
+     *
+     */
+    void notifyFileEvent(const FileEvent& event);
+
+    /** Call the chunk callbacks of all subscribers.
      *
      */
-    FileObject receiveFile(const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
+    void notifyChunk(const std::string& name, const uint8_t* data, size_t size, size_t offset);
+
+    /** Check if a file is in the list of files to skip.
+     *
+     */
+    bool isFileToSkip(const std::string& name) const;
+
+    /** Check if the content of a received file is already in the deduplication index.
+     *
+     */
+    bool isDuplicateFile(const FileObject& file);
+
+    /** Get a function which adds a received file to the deduplication index once it is stored.
+     *
+     * \param  file The received file with its SHA-256.
+     * \return The function, to be called with true when the file was committed, or nullptr if there is no index.
+     */
+    std::function<void(bool)> recordOnCommit(const FileObject& file);
+
+    /** Read and drop the rest of a file whose transfer was aborted.
+     *
+     */
+    void discardStaleTelegrams();
 
     /** Start the receive thread.
      *
@@ -193,18 +478,48 @@ private:
     void fileReceiverJob();
 
 
+    /** Send the request for a single file.
+     *
+     */
+    void requestFile(const std::string& filename);
+
     std::string connectionName;
     ZenniumConnection * remoteConnection;
 
-    bool receiving_worker_is_running;
+    std::atomic<bool> receiving_worker_is_running;
     std::thread *receivingWorker;
 
+    mutable std::mutex workerMutex;
+    std::condition_variable workerFinished;
+    bool receiving_worker_is_finished;
+    std::chrono::milliseconds stopDeadline;
+    ExchangeStatistics exchangeStatistics;
+    std::atomic<long long> staleBytes;
+    std::atomic<bool> staleLengthPending;
+
     bool automaticFileExchange;
-    std::vector<std::string>filesToSkip;
-    std::vector<FileObject>receivedFiles;
+    mutable std::mutex skipMutex;
+    std::unordered_set<std::string> filesToSkip;
+    std::vector<std::string> filePatternsToSkip;
+
+    std::atomic<bool> hashReceivedFiles;
+    std::shared_ptr<ReceivedFileIndex> fileIndex;
+    std::atomic<unsigned long> duplicateFiles;
+    std::unique_ptr<ReceivedFileStore> receivedFiles;
     std::string pathToSave;
     bool saveReceivedFilesToDisk;
     bool keepReceivedFilesInObject;
+
+    std::mutex subscriberMutex;
+    std::map<uint64_t, Subscription> subscribers;
+    uint64_t nextSubscriberId;
+    uint64_t fileReceivedCallbackId;
+    std::atomic<int> chunkSubscribers;
+
+    std::mutex sinkMutex;
+    ReceivedFileSink* receivedFileSink;
+
+    FileWriteBehind fileWriter;
 };
 
 #endif // THALESFILEINTERFACE_H
@@ -189,24 +189,37 @@ int ZenniumConnection::sendall(SOCKET s, char *data, int dataSize, int flags)
 
 void ZenniumConnection::sendTelegram(std::string payload, int message_type)
 {
-    std::vector<unsigned char> bytes(payload.begin(), payload.end());
-    this->sendTelegram(bytes, message_type);
+    this->sendTelegram(reinterpret_cast<const uint8_t *>(payload.data()), payload.size(), message_type);
 }
 
 void ZenniumConnection::sendTelegram(std::vector<unsigned char> payload, int message_type)
 {
+    this->sendTelegram(payload.data(), payload.size(), message_type);
+}
+
+void ZenniumConnection::sendTelegram(const uint8_t* payload, size_t payloadSize, int message_type)
+{
+    std::lock_guard<std::mutex> lock(this->sendMutex);
 
-    std::vector<unsigned char> packet;
-    uint16_t payload_length = static_cast<uint16_t>(payload.size());
+    uint16_t payload_length = static_cast<uint16_t>(payloadSize);
 
-    packet.reserve(payload_length + 3);
-    packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[0]);
-    packet.push_back(reinterpret_cast<unsigned char *>(&payload_length)[1]);
-    packet.push_back(message_type);
+    this->sendBuffer.resize(payloadSize + 3);
+    this->sendBuffer[0] = reinterpret_cast<unsigned char *>(&payload_length)[0];
+    this->sendBuffer[1] = reinterpret_cast<unsigned char *>(&payload_length)[1];
+    this->sendBuffer[2] = static_cast<unsigned char>(message_type);
+
+    if (payloadSize > 0)
+    {
+        std::memcpy(this->sendBuffer.data() + 3, payload, payloadSize);
+    }
 
-    packet.insert(packet.end(), payload.begin(), payload.end());
+    const int64_t sendTime = getMonotonicTimeInNanoseconds();
+    int status = sendall(this->socket_handle, reinterpret_cast<char *>(this->sendBuffer.data()), static_cast<int>(this->sendBuffer.size()), 0);
 
-    int status = sendall(this->socket_handle, reinterpret_cast<char *>(packet.data()), static_cast<int>(packet.size()), 0);
+    {
+        std::lock_guard<std::mutex> timestampLock(this->timestampMutex);
+        this->lastTimestamps[message_type].sendTime = sendTime;
+    }
 
     if(status == -1)
     {
@@ -226,8 +239,13 @@ std::vector<uint8_t> ZenniumConnection::waitForBinaryTelegram(int message_type)
 
 std::vector<uint8_t> ZenniumConnection::waitForTelegram(int message_type, const std::chrono::duration<int, std::milli> timeout) {
 
-    auto receivedTelegram = this->queuesForChannels[message_type]->get(true, timeout);
+    int64_t receiveTime = 0;
+    auto receivedTelegram = this->queuesForChannels[message_type]->get(true, timeout, &receiveTime);
 
+    {
+        std::lock_guard<std::mutex> lock(this->timestampMutex);
+        this->lastTimestamps[message_type].receiveTime = receiveTime;
+    }
 
     if(receivedTelegram.size() == 0)
     {
@@ -260,6 +278,11 @@ bool ZenniumConnection::isTelegramAvailable(int message_type)
     return !empty;
 }
 
+void ZenniumConnection::setWaitInterrupted(int message_type, bool interrupted)
+{
+    this->queuesForChannels[message_type]->setInterrupted(interrupted);
+}
+
 std::string ZenniumConnection::sendStringAndWaitForReplyString(std::string payload, int message_type)
 {
     return this->sendStringAndWaitForReplyString(payload, message_type, this->defaultTimeout, message_type);
@@ -291,6 +314,18 @@ std::chrono::duration<int, std::milli> ZenniumConnection::getTimeout()
     return this->defaultTimeout;
 }
 
+TelegramTimestamps ZenniumConnection::getLastTimestamps(int message_type)
+{
+    std::lock_guard<std::mutex> lock(this->timestampMutex);
+    return this->lastTimestamps[message_type];
+}
+
+void ZenniumConnection::setTelegramObserver(TelegramObserver observer)
+{
+    std::lock_guard<std::mutex> lock(this->observerMutex);
+    this->telegramObserver = std::move(observer);
+}
+
 std::tuple<int, std::vector<uint8_t>> ZenniumConnection::readTelegramFromSocket()
 {
     bool connectionInterrupted = false;
@@ -363,10 +398,20 @@ void ZenniumConnection::telegramListenerJob()
 {
     do {
         auto telegram = readTelegramFromSocket();
+        const int64_t receiveTime = getMonotonicTimeInNanoseconds();
+
+        if (std::get<1>(telegram).size() > 0)
+        {
+            std::lock_guard<std::mutex> lock(this->observerMutex);
+            if (this->telegramObserver && this->telegramObserver(std::get<0>(telegram), std::get<1>(telegram)) == true)
+            {
+                continue;
+            }
+        }
 
         if (std::get<1>(telegram).size() > 0 && std::find(availableChannels.begin(), availableChannels.end(), std::get<0>(telegram)) != availableChannels.end())
         {
-            this->queuesForChannels[std::get<0>(telegram)]->put(std::get<1>(telegram));
+            this->queuesForChannels[std::get<0>(telegram)]->put(std::move(std::get<1>(telegram)), receiveTime);
         }
         else if(std::get<0>(telegram) == -1)
         {
@@ -39,7 +39,9 @@
 #include <vector>
 #include <unordered_map>
 #include "threadsafequeue.h"
+#include "timestampedvalue.h"
 #include <memory>
+#include <functional>
 
 #ifdef _WIN32
 
@@ -120,6 +122,17 @@ public:
      */
     void sendTelegram(std::vector<unsigned char> payload, int message_type);
 
+    /** Send a telegram (data) to Term.
+     *
+     *  The packet is assembled in a buffer owned by the connection, which keeps its capacity.
+     *  After the first telegrams no memory is allocated for sending.
+     *
+     * \param  payload Pointer to the data which is being sent to Term.
+     * \param  payloadSize Number of bytes to send.
+     * \param  message_type Used internally by the DevCli dll. Depends on context. Most of the time 2.
+     */
+    void sendTelegram(const uint8_t* payload, size_t payloadSize, int message_type);
+
     std::string waitForStringTelegram(int message_type);
     /** Block maximal timeout milliseconds while waiting for an incoming telegram.
      *
@@ -142,6 +155,16 @@ public:
      */
     bool isTelegramAvailable(int message_type);
 
+    /** Interrupt the waiting for telegrams on a channel.
+     *
+     * While a channel is interrupted, the wait methods do not block: they return a telegram which is
+     * already available or throw a TermConnectionError. Threads which are already waiting are woken up.
+     *
+     * \param  message_type The channel.
+     * \param  interrupted true to interrupt, false to allow waiting again.
+     */
+    void setWaitInterrupted(int message_type, bool interrupted);
+
     std::vector<uint8_t> waitForTelegram(int message_type);
     std::vector<uint8_t> waitForBinaryTelegram(int message_type);
     /** Block maximal timeout milliseconds while waiting for an incoming telegram.
@@ -218,6 +241,35 @@ public:
      */
     std::chrono::duration<int, std::milli> getTimeout();
 
+    /** Function which observes the incoming telegrams.
+     *
+     *  The arguments are the channel (message type) and the payload. If the function returns true, the telegram
+     *  is consumed and not put into the queue of the channel.
+     */
+    typedef std::function<bool(int, const std::vector<uint8_t>&)> TelegramObserver;
+
+    /** Set a function which is called for every incoming telegram.
+     *
+     *  Telegrams on channels other than the standard channels are otherwise discarded. This is used for
+     *  connections in Watch or Logging mode, which only receive telegrams. The function is called in the
+     *  receiving thread and must return quickly.
+     *
+     * \param  observer The function or nullptr to remove the observer.
+     */
+    void setTelegramObserver(TelegramObserver observer);
+
+    /** Get the timestamps of the last request on a channel.
+     *
+     *  The send time is taken when the last telegram of the channel was written to the socket, the receive
+     *  time when the last telegram read with a wait method arrived at the socket. For the request/reply
+     *  channels 2 and 128 these are the times of the last request and its reply.
+     *
+     * \param  message_type The channel.
+     *
+     * \return The timestamps in nanoseconds, see getMonotonicTimeInNanoseconds.
+     */
+    TelegramTimestamps getLastTimestamps(int message_type);
+
 protected:
     std::chrono::duration<int, std::milli> defaultTimeout;
 
@@ -226,6 +278,9 @@ protected:
 
     SOCKET socket_handle;
 
+    std::mutex sendMutex;
+    std::vector<unsigned char> sendBuffer;
+
     std::vector<int> availableChannels;
 
     std::unordered_map<int, std::shared_ptr<ThreadsafeQueue>> queuesForChannels;
@@ -233,6 +288,12 @@ protected:
     bool receiving_worker_is_running;
     std::thread *receivingWorker;
 
+    std::mutex observerMutex;
+    TelegramObserver telegramObserver;
+
+    std::mutex timestampMutex;
+    std::unordered_map<int, TelegramTimestamps> lastTimestamps;
+
     /** The method running in a separate thread, pushing the incomming packets into the queue. */
     void telegramListenerJob();
 
@@ -26,17 +26,12 @@
 
 #include "thalesremotescriptwrapper.h"
 #include <algorithm>
+#include <array>
 #include <iomanip>
 #include <sstream>
 #include "termconnectionerror.h"
 #include "thalesremoteerror.h"
-
-template <typename T>
-std::string to_string_with_precision(const T value, const int n = 6) {
-    std::stringstream out;
-    out << std::scientific << std::setprecision(n) << value;
-    return out.str();
-}
+#include "remoteparameters.h"
 
 std::vector<int> tokenize(const std::string& str, char delim) {
     std::vector<int> tokens;
@@ -100,7 +95,20 @@ ThalesRemoteScriptWrapper::ThalesRemoteScriptWrapper(ZenniumConnection* const re
 }
 
 std::string ThalesRemoteScriptWrapper::executeRemoteCommand(std::string command) {
-    return remoteConnection->sendStringAndWaitForReplyString("1:" + command + ":", 2);
+    return this->executeEncodedCommand(this->commandEncoder.encodeCommand(command));
+}
+
+void ThalesRemoteScriptWrapper::sendRemoteCommand(std::string command) {
+    const auto telegram = this->commandEncoder.encodeCommand(command);
+    remoteConnection->sendTelegram(reinterpret_cast<const uint8_t*>(telegram.data()), telegram.size(), 2);
+}
+
+bool ThalesRemoteScriptWrapper::isRemoteReplyAvailable() {
+    return remoteConnection->isTelegramAvailable(2);
+}
+
+std::string ThalesRemoteScriptWrapper::readRemoteReply() {
+    return remoteConnection->waitForStringTelegram(2);
 }
 
 std::string ThalesRemoteScriptWrapper::forceThalesIntoRemoteScript() {
@@ -172,24 +180,42 @@ double ThalesRemoteScriptWrapper::getPotential() {
     return this->requestValueAndParseUsingRegexp("POTENTIAL", std::regex("potential=\\s*(.*?)V"));
 }
 
+TimestampedValue<double> ThalesRemoteScriptWrapper::getCurrentTimestamped() {
+    TimestampedValue<double> retval;
+    retval.value      = this->getCurrent();
+    retval.timestamps = this->getLastCommandTimestamps();
+    return retval;
+}
+
+TimestampedValue<double> ThalesRemoteScriptWrapper::getPotentialTimestamped() {
+    TimestampedValue<double> retval;
+    retval.value      = this->getPotential();
+    retval.timestamps = this->getLastCommandTimestamps();
+    return retval;
+}
+
+TelegramTimestamps ThalesRemoteScriptWrapper::getLastCommandTimestamps() {
+    return remoteConnection->getLastTimestamps(2);
+}
+
 double ThalesRemoteScriptWrapper::getVoltage() {
     return this->getPotential();
 }
 
 std::string ThalesRemoteScriptWrapper::setCurrent(double current) {
-    return this->setValue("Cset", current);
+    return this->setParameter(Parameters::Current, current);
 }
 
 std::string ThalesRemoteScriptWrapper::setPotential(double potential) {
-    return this->setValue("Pset", potential);
+    return this->setParameter(Parameters::Potential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setMaximumShuntIndex(int shunt) {
-    return this->setValue("Rmax", shunt);
+    return this->setParameter(Parameters::MaximumShuntIndex, shunt);
 }
 
 std::string ThalesRemoteScriptWrapper::setMinimumShuntIndex(int shunt) {
-    return this->setValue("Rmin", shunt);
+    return this->setParameter(Parameters::MinimumShuntIndex, shunt);
 }
 
 std::string ThalesRemoteScriptWrapper::setShuntIndex(int index) {
@@ -198,15 +224,15 @@ std::string ThalesRemoteScriptWrapper::setShuntIndex(int index) {
 }
 
 std::string ThalesRemoteScriptWrapper::setVoltageRangeIndex(int index) {
-    return this->setValue("Potrange", index);
+    return this->setParameter(Parameters::VoltageRangeIndex, index);
 }
 
 std::string ThalesRemoteScriptWrapper::selectPotentiostat(int device) {
-    return this->setValue("DEV%", device);
+    return this->setParameter(Parameters::Potentiostat, device);
 }
 
 std::string ThalesRemoteScriptWrapper::selectPotentiostatWithoutPotentiostatStateChange(int device) {
-    return this->setValue("DEVHOT%", device);
+    return this->setParameter(Parameters::PotentiostatWithoutStateChange, device);
 }
 
 std::string ThalesRemoteScriptWrapper::switchToSCPIControl() {
@@ -251,16 +277,98 @@ std::string ThalesRemoteScriptWrapper::readSetup() {
     return this->executeRemoteCommand("SENDSETUP");
 }
 
+SetupSnapshot ThalesRemoteScriptWrapper::readSetupSnapshot() {
+    auto reply = this->readSetup();
+
+    if (reply.find("ERROR") != std::string::npos) {
+        throw ThalesRemoteError(reply);
+    }
+
+    return SetupSnapshot::fromReply(reply);
+}
+
+static const std::array<std::string_view, 9> keysNotToRestore = {
+    RemoteParameter::DEV, RemoteParameter::DEVHOT, RemoteParameter::Pot, "EPC", "MAXDEV",
+    "Cmin",               "Cmax",                  "Pmin",              "Pmax"
+};
+
+int ThalesRemoteScriptWrapper::restoreSetup(const SetupSnapshot& target) {
+    typedef std::string (ThalesRemoteScriptWrapper::*SetupReader)();
+    static const std::array<SetupReader, 5> otherSetups = {
+        &ThalesRemoteScriptWrapper::readCVSetup,  &ThalesRemoteScriptWrapper::readIESetup,
+        &ThalesRemoteScriptWrapper::readPAD4Setup, &ThalesRemoteScriptWrapper::readFraSetup,
+        &ThalesRemoteScriptWrapper::readSequenceAcqSetup
+    };
+
+    SetupSnapshot current = this->readSetupSnapshot();
+
+    /*
+     * SENDSETUP does not report the parameters of the CV, IE, PAD4, FRA and sequence setups. Without their
+     * current values those parameters would be sent on every restore, so the other setups are read as long
+     * as parameters of the target are still unknown.
+     */
+    auto isUnknown = [&current](const SetupSnapshot::Entry& entry) {
+        return current.contains(entry.key) == false &&
+               std::find(keysNotToRestore.begin(), keysNotToRestore.end(), entry.key) == keysNotToRestore.end();
+    };
+
+    for (auto reader : otherSetups) {
+        const auto& entries = target.getEntries();
+        if (std::none_of(entries.begin(), entries.end(), isUnknown)) {
+            break;
+        }
+
+        std::string reply;
+        try {
+            reply = (this->*reader)();
+        } catch (const ThalesRemoteError&) {
+            continue;
+        }
+        if (reply.find("ERROR") == std::string::npos) {
+            current.merge(SetupSnapshot::fromReply(reply));
+        }
+    }
+
+    return this->restoreSetup(target, current);
+}
+
+int ThalesRemoteScriptWrapper::restoreSetup(const SetupSnapshot& target, const SetupSnapshot& current) {
+    int sent = 0;
+    for (const auto& entry : target.differencesTo(current)) {
+        if (std::find(keysNotToRestore.begin(), keysNotToRestore.end(), entry.key) != keysNotToRestore.end()) {
+            continue;
+        }
+
+        const auto telegram = this->commandEncoder.encodeParameter(entry.key, std::string_view(entry.value));
+        remoteConnection->sendTelegram(reinterpret_cast<const uint8_t*>(telegram.data()), telegram.size(), 2);
+        sent++;
+    }
+
+    /*
+     * Remote Script answers in the order of the commands. All responses must be read,
+     * even if one of them is an error, otherwise they would be read by the next commands.
+     */
+    std::string errors;
+    for (int i = 0; i < sent; i++) {
+        auto reply = remoteConnection->waitForStringTelegram(2);
+        if (reply.find("ERROR") != std::string::npos) {
+            errors += reply;
+        }
+    }
+
+    if (errors.empty() == false) {
+        throw ThalesRemoteError(errors);
+    }
+
+    return sent;
+}
+
 std::string ThalesRemoteScriptWrapper::calibrateOffsets() {
     return this->executeRemoteCommand("CALOFFSETS");
 }
 
 std::string ThalesRemoteScriptWrapper::enablePotentiostat(bool enabled) {
-    if (enabled == true) {
-        return this->executeRemoteCommand("Pot=-1");
-    } else {
-        return this->executeRemoteCommand("Pot=0");
-    }
+    return this->executeEncodedCommand(this->commandEncoder.encodeParameter(RemoteParameter::Pot, enabled == true ? -1 : 0));
 }
 
 std::string ThalesRemoteScriptWrapper::disablePotentiostat() {
@@ -289,7 +397,7 @@ std::string ThalesRemoteScriptWrapper::setPotentiostatMode(PotentiostatMode pote
 }
 
 std::string ThalesRemoteScriptWrapper::enableRuleFileUsage(bool enabled) {
-    return this->setValue("UseRuleFile", enabled);
+    return this->setValue(RemoteParameter::UseRuleFile, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableRuleFileUsage() {
@@ -297,9 +405,12 @@ std::string ThalesRemoteScriptWrapper::disableRuleFileUsage() {
 }
 
 std::string ThalesRemoteScriptWrapper::setupPad4Channel(int card, int channel, bool enabled) {
-    int enable          = (enabled == true) ? 1 : 0;
-    std::string command = "PAD4=" + std::to_string(card) + ";" + std::to_string(channel) + ";" + std::to_string(enable);
-    auto reply          = this->executeRemoteCommand(command);
+    Parameters::Pad4Card.check(card, "card");
+    Parameters::Pad4Channel.check(channel, "channel");
+
+    auto reply = this->executeEncodedCommand(
+        this->commandEncoder.encodeParameter(RemoteParameter::PAD4, card, channel, enabled)
+    );
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -311,10 +422,11 @@ std::string ThalesRemoteScriptWrapper::setupPad4Channel(int card, int channel, b
 std::string ThalesRemoteScriptWrapper::setupPad4ChannelWithVoltageRange(
     int card, int channel, bool enabled, double voltageRange
 ) {
+    Parameters::Pad4VoltageRange.check(voltageRange);
     setupPad4Channel(card, channel, enabled);
-    std::string command =
-        "PAD4_PRANGE=" + std::to_string(card) + ";" + std::to_string(channel) + ";" + std::to_string(voltageRange);
-    auto reply = this->executeRemoteCommand(command);
+    auto reply = this->executeEncodedCommand(
+        this->commandEncoder.encodeParameter(RemoteParameter::PAD4_PRANGE, card, channel, voltageRange)
+    );
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -326,10 +438,11 @@ std::string ThalesRemoteScriptWrapper::setupPad4ChannelWithVoltageRange(
 std::string ThalesRemoteScriptWrapper::setupPad4ChannelWithShuntResistor(
     int card, int channel, bool enabled, double shuntResistor
 ) {
+    Parameters::Pad4ShuntResistor.check(shuntResistor);
     setupPad4Channel(card, channel, enabled);
-    std::string command =
-        "PAD4_RSHUNT=" + std::to_string(card) + ";" + std::to_string(channel) + ";" + std::to_string(shuntResistor);
-    auto reply = this->executeRemoteCommand(command);
+    auto reply = this->executeEncodedCommand(
+        this->commandEncoder.encodeParameter(RemoteParameter::PAD4_RSHUNT, card, channel, shuntResistor)
+    );
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -349,11 +462,11 @@ std::string ThalesRemoteScriptWrapper::setupPad4ModeGlobal(Pad4Mode mode) {
             intmode = 1;
             break;
     }
-    return this->setValue("PAD4MOD", intmode);
+    return this->setValue(RemoteParameter::PAD4MOD, intmode);
 }
 
 std::string ThalesRemoteScriptWrapper::enablePad4Global(bool enabled) {
-    return this->setValue("PAD4ENA", enabled);
+    return this->setValue(RemoteParameter::PAD4ENA, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disablePad4Global() {
@@ -371,11 +484,12 @@ std::string ThalesRemoteScriptWrapper::readPAD4Setup() {
 }
 
 std::string ThalesRemoteScriptWrapper::setFrequency(double frequency) {
-    return this->setValue("Frq", frequency);
+    return this->setParameter(Parameters::Frequency, frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setAmplitude(double amplitude) {
-    return this->setValue("Ampl", amplitude * 1e3);
+    Parameters::Amplitude.check(amplitude);
+    return this->setValue(RemoteParameter::Ampl, amplitude * 1e3);
 }
 
 std::string ThalesRemoteScriptWrapper::setNumberOfPeriods(int numberOfPeriods) {
@@ -389,35 +503,35 @@ std::string ThalesRemoteScriptWrapper::setNumberOfPeriods(int numberOfPeriods) {
         numberOfPeriods = 1;
     }
 
-    return this->setValue("Nw", numberOfPeriods);
+    return this->setParameter(Parameters::NumberOfPeriods, numberOfPeriods);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperFrequencyLimit(double frequency) {
-    return this->setValue("Fmax", frequency);
+    return this->setParameter(Parameters::UpperFrequencyLimit, frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerFrequencyLimit(double frequency) {
-    return this->setValue("Fmin", frequency);
+    return this->setParameter(Parameters::LowerFrequencyLimit, frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setStartFrequency(double frequency) {
-    return this->setValue("Fstart", frequency);
+    return this->setParameter(Parameters::StartFrequency, frequency);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperStepsPerDecade(int steps) {
-    return this->setValue("dfm", steps);
+    return this->setParameter(Parameters::UpperStepsPerDecade, steps);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerStepsPerDecade(int steps) {
-    return this->setValue("dfl", steps);
+    return this->setParameter(Parameters::LowerStepsPerDecade, steps);
 }
 
 std::string ThalesRemoteScriptWrapper::setUpperNumberOfPeriods(int periods) {
-    return this->setValue("Nws", periods);
+    return this->setParameter(Parameters::UpperNumberOfPeriods, periods);
 }
 
 std::string ThalesRemoteScriptWrapper::setLowerNumberOfPeriods(int periods) {
-    return this->setValue("Nwl", periods);
+    return this->setParameter(Parameters::LowerNumberOfPeriods, periods);
 }
 
 std::string ThalesRemoteScriptWrapper::setScanStrategy(ScanStrategy strategy) {
@@ -434,7 +548,7 @@ std::string ThalesRemoteScriptWrapper::setScanStrategy(ScanStrategy strategy) {
             strategyInt = 2;
             break;
     }
-    return this->setValue("ScanStrategy", strategyInt);
+    return this->setValue(RemoteParameter::ScanStrategy, strategyInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setScanDirection(ScanDirection direction) {
@@ -448,7 +562,7 @@ std::string ThalesRemoteScriptWrapper::setScanDirection(ScanDirection direction)
             directionInt = 1;
             break;
     }
-    return this->setValue("ScanDirection", directionInt);
+    return this->setValue(RemoteParameter::ScanDirection, directionInt);
 }
 
 std::complex<double> ThalesRemoteScriptWrapper::getImpedance() {
@@ -485,6 +599,70 @@ std::complex<double> ThalesRemoteScriptWrapper::getImpedance(double frequency, d
     return this->getImpedance();
 }
 
+AdaptiveImpedanceResult ThalesRemoteScriptWrapper::getImpedanceAdaptive(
+    double frequency, double amplitude, const AdaptiveImpedanceSettings& settings
+) {
+    AdaptiveImpedanceResult result;
+
+    this->setFrequency(frequency);
+    this->setAmplitude(amplitude);
+
+    const int maximumPeriods = std::max(1, std::min(settings.maximumPeriods, 100));
+    int periods              = std::max(1, std::min(settings.initialPeriods, maximumPeriods));
+    int setPeriods           = -1;
+
+    std::complex<double> previous(std::nan("1"), std::nan("1"));
+    std::complex<double> weightedSum(0.0, 0.0);
+    double weightedSquares     = 0.0;
+    double sumOfWeights        = 0.0;
+    double sumOfSquaredWeights = 0.0;
+
+    while (result.measurements < std::max(1, settings.maximumMeasurements)) {
+        if (periods != setPeriods) {
+            this->setNumberOfPeriods(periods);
+            setPeriods = periods;
+        }
+
+        const std::complex<double> impedance = this->getImpedance();
+        const double weight                  = static_cast<double>(periods);
+
+        result.measurements++;
+        result.totalPeriods += periods;
+        result.lastPeriods = periods;
+
+        weightedSum += weight * impedance;
+        weightedSquares += weight * std::norm(impedance);
+        sumOfWeights += weight;
+        sumOfSquaredWeights += weight * weight;
+        result.impedance = weightedSum / sumOfWeights;
+
+        const double magnitude = std::abs(result.impedance);
+
+        if (result.measurements > 1 && magnitude > 0.0) {
+            // weighted variance of the estimates and standard error with the effective number of measurements
+            const double variance        = std::max(0.0, weightedSquares / sumOfWeights - std::norm(result.impedance));
+            const double effectiveNumber = sumOfWeights * sumOfWeights / sumOfSquaredWeights;
+            result.relativeStandardError = std::sqrt(variance / std::max(1.0, effectiveNumber - 1.0)) / magnitude;
+            result.relativeDifference    = std::abs(impedance - previous) / magnitude;
+
+            if (result.relativeDifference <= settings.relativeTolerance) {
+                result.converged = true;
+                break;
+            }
+
+            if (settings.targetConfidence > 0.0 && result.relativeStandardError <= settings.targetConfidence) {
+                result.converged = true;
+                break;
+            }
+        }
+
+        previous = impedance;
+        periods  = std::min(2 * periods, maximumPeriods);
+    }
+
+    return result;
+}
+
 std::string ThalesRemoteScriptWrapper::getImpedancePad4() {
     std::string reply = this->executeRemoteCommand("PAD4IMP");
 
@@ -509,6 +687,24 @@ std::string ThalesRemoteScriptWrapper::getImpedancePad4(double frequency, double
     return this->getImpedancePad4();
 }
 
+Pad4Impedance ThalesRemoteScriptWrapper::measurePad4Impedance() {
+    return Pad4Impedance::fromReply(this->getImpedancePad4());
+}
+
+Pad4Impedance ThalesRemoteScriptWrapper::measurePad4Impedance(double frequency) {
+    this->setFrequency(frequency);
+
+    return this->measurePad4Impedance();
+}
+
+Pad4Impedance ThalesRemoteScriptWrapper::measurePad4Impedance(double frequency, double amplitude, int numberOfPeriods) {
+    this->setFrequency(frequency);
+    this->setAmplitude(amplitude);
+    this->setNumberOfPeriods(numberOfPeriods);
+
+    return this->measurePad4Impedance();
+}
+
 std::string ThalesRemoteScriptWrapper::setEISNaming(NamingRule naming) {
     int namingInt;
     switch (naming) {
@@ -523,20 +719,20 @@ std::string ThalesRemoteScriptWrapper::setEISNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("EIS_MOD", namingInt);
+    return this->setValue(RemoteParameter::EIS_MOD, namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISCounter(int number) {
-    return this->setValue("EIS_NUM", number);
+    return this->setParameter(Parameters::EISCounter, number);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("EIS_PATH", path);
+    return this->setValue(RemoteParameter::EIS_PATH, path);
 }
 
 std::string ThalesRemoteScriptWrapper::setEISOutputFileName(std::string name) {
-    return this->setValue("EIS_ROOT", name);
+    return this->setValue(RemoteParameter::EIS_ROOT, name);
 }
 
 std::string ThalesRemoteScriptWrapper::measureEIS() {
@@ -550,55 +746,55 @@ std::string ThalesRemoteScriptWrapper::measureEIS() {
 }
 
 std::string ThalesRemoteScriptWrapper::setCVStartPotential(double potential) {
-    return this->setValue("CV_Pstart", potential);
+    return this->setParameter(Parameters::CVStartPotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVUpperReversingPotential(double potential) {
-    return this->setValue("CV_Pupper", potential);
+    return this->setParameter(Parameters::CVUpperReversingPotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVLowerReversingPotential(double potential) {
-    return this->setValue("CV_Plower", potential);
+    return this->setParameter(Parameters::CVLowerReversingPotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVEndPotential(double potential) {
-    return this->setValue("CV_Pend", potential);
+    return this->setParameter(Parameters::CVEndPotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVStartHoldTime(double time) {
-    return this->setValue("CV_Tstart", time);
+    return this->setParameter(Parameters::CVStartHoldTime, time);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVEndHoldTime(double time) {
-    return this->setValue("CV_Tend", time);
+    return this->setParameter(Parameters::CVEndHoldTime, time);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVScanRate(double scanRate) {
-    return this->setValue("CV_Srate", scanRate);
+    return this->setParameter(Parameters::CVScanRate, scanRate);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVCycles(double cycles) {
-    return this->setValue("CV_Periods", cycles);
+    return this->setParameter(Parameters::CVCycles, cycles);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVSamplesPerCycle(double samples) {
-    return this->setValue("CV_PpPer", samples);
+    return this->setParameter(Parameters::CVSamplesPerCycle, samples);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVMaximumCurrent(double current) {
-    return this->setValue("CV_Ima", current);
+    return this->setParameter(Parameters::CVMaximumCurrent, current);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVMinimumCurrent(double current) {
-    return this->setValue("CV_Imi", current);
+    return this->setParameter(Parameters::CVMinimumCurrent, current);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOhmicDrop(double ohmicDrop) {
-    return this->setValue("CV_Odrop", ohmicDrop);
+    return this->setParameter(Parameters::CVOhmicDrop, ohmicDrop);
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentOverflow(bool enabled) {
-    return this->setValue("CV_AutoReStart", enabled);
+    return this->setValue(RemoteParameter::CV_AutoReStart, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentOverflow() {
@@ -606,7 +802,7 @@ std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentOverflow() {
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAutoRestartAtCurrentUnderflow(bool enabled) {
-    return this->setValue("CV_AutoScale", enabled);
+    return this->setValue(RemoteParameter::CV_AutoScale, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentUnderflow() {
@@ -614,7 +810,7 @@ std::string ThalesRemoteScriptWrapper::disableCVAutoRestartAtCurrentUnderflow()
 }
 
 std::string ThalesRemoteScriptWrapper::enableCVAnalogFunctionGenerator(bool enabled) {
-    return this->setValue("CV_AFGena", enabled);
+    return this->setValue(RemoteParameter::CV_AFGena, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableCVAnalogFunctionGenerator() {
@@ -635,20 +831,20 @@ std::string ThalesRemoteScriptWrapper::setCVNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("CV_MOD", namingInt);
+    return this->setValue(RemoteParameter::CV_MOD, namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVCounter(int number) {
-    return this->setValue("CV_NUM", number);
+    return this->setParameter(Parameters::CVCounter, number);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("CV_PATH", path);
+    return this->setValue(RemoteParameter::CV_PATH, path);
 }
 
 std::string ThalesRemoteScriptWrapper::setCVOutputFileName(std::string name) {
-    return this->setValue("CV_ROOT", name);
+    return this->setValue(RemoteParameter::CV_ROOT, name);
 }
 
 std::string ThalesRemoteScriptWrapper::checkCVSetup() {
@@ -682,59 +878,59 @@ std::string ThalesRemoteScriptWrapper::measureCV() {
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFirstEdgePotential(double potential) {
-    return this->setValue("IE_EckPot1", potential);
+    return this->setParameter(Parameters::IEFirstEdgePotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIESecondEdgePotential(double potential) {
-    return this->setValue("IE_EckPot2", potential);
+    return this->setParameter(Parameters::IESecondEdgePotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEThirdEdgePotential(double potential) {
-    return this->setValue("IE_EckPot3", potential);
+    return this->setParameter(Parameters::IEThirdEdgePotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFourthEdgePotential(double potential) {
-    return this->setValue("IE_EckPot4", potential);
+    return this->setParameter(Parameters::IEFourthEdgePotential, potential);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFirstEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot1rel", relation);
+    return this->setValue(RemoteParameter::IE_EckPot1rel, relation);
 }
 
 std::string ThalesRemoteScriptWrapper::setIESecondEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot2rel", relation);
+    return this->setValue(RemoteParameter::IE_EckPot2rel, relation);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEThirdEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot3rel", relation);
+    return this->setValue(RemoteParameter::IE_EckPot3rel, relation);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEFourthEdgePotentialRelation(PotentialRelation relation) {
-    return this->setValue("IE_EckPot4rel", relation);
+    return this->setValue(RemoteParameter::IE_EckPot4rel, relation);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEPotentialResolution(double resolution) {
-    return this->setValue("IE_Resolution", resolution);
+    return this->setParameter(Parameters::IEPotentialResolution, resolution);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMinimumWaitingTime(double time) {
-    return this->setValue("IE_WZmin", time);
+    return this->setParameter(Parameters::IEMinimumWaitingTime, time);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMaximumWaitingTime(double time) {
-    return this->setValue("IE_WZmax", time);
+    return this->setParameter(Parameters::IEMaximumWaitingTime, time);
 }
 
 std::string ThalesRemoteScriptWrapper::setIERelativeTolerance(double tolerance) {
-    return this->setValue("IE_Torel", tolerance);
+    return this->setParameter(Parameters::IERelativeTolerance, tolerance);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEAbsoluteTolerance(double tolerance) {
-    return this->setValue("IE_Toabs", tolerance);
+    return this->setParameter(Parameters::IEAbsoluteTolerance, tolerance);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOhmicDrop(double ohmicDrop) {
-    return this->setValue("IE_Odrop", ohmicDrop);
+    return this->setParameter(Parameters::IEOhmicDrop, ohmicDrop);
 }
 
 std::string ThalesRemoteScriptWrapper::setIESweepMode(IESweepMode sweepMode) {
@@ -751,19 +947,19 @@ std::string ThalesRemoteScriptWrapper::setIESweepMode(IESweepMode sweepMode) {
             sweepModeInt = 0;
             break;
     }
-    return this->setValue("IE_SweepMode", sweepModeInt);
+    return this->setValue(RemoteParameter::IE_SweepMode, sweepModeInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEScanRate(double scanRate) {
-    return this->setValue("IE_Srate", scanRate);
+    return this->setParameter(Parameters::IEScanRate, scanRate);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMaximumCurrent(double current) {
-    return this->setValue("IE_Ima", current);
+    return this->setParameter(Parameters::IEMaximumCurrent, current);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEMinimumCurrent(double current) {
-    return this->setValue("IE_Imi", current);
+    return this->setParameter(Parameters::IEMinimumCurrent, current);
 }
 
 std::string ThalesRemoteScriptWrapper::setIENaming(NamingRule naming) {
@@ -780,20 +976,20 @@ std::string ThalesRemoteScriptWrapper::setIENaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("IE_MOD", namingInt);
+    return this->setValue(RemoteParameter::IE_MOD, namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setIECounter(int number) {
-    return this->setValue("IE_NUM", number);
+    return this->setParameter(Parameters::IECounter, number);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("IE_PATH", path);
+    return this->setValue(RemoteParameter::IE_PATH, path);
 }
 
 std::string ThalesRemoteScriptWrapper::setIEOutputFileName(std::string name) {
-    return this->setValue("IE_ROOT", name);
+    return this->setValue(RemoteParameter::IE_ROOT, name);
 }
 
 std::string ThalesRemoteScriptWrapper::checkIESetup() {
@@ -827,7 +1023,9 @@ std::string ThalesRemoteScriptWrapper::measureIE() {
 }
 
 std::string ThalesRemoteScriptWrapper::selectSequence(int number) {
-    auto reply = this->executeRemoteCommand("SELSEQ=" + std::to_string(number));
+    Parameters::Sequence.check(number);
+
+    auto reply = this->executeEncodedCommand(this->commandEncoder.encodeParameter(RemoteParameter::SELSEQ, number));
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -850,24 +1048,24 @@ std::string ThalesRemoteScriptWrapper::setSequenceNaming(NamingRule naming) {
             namingInt = 2;
             break;
     }
-    return this->setValue("SEQ_MOD", namingInt);
+    return this->setValue(RemoteParameter::SEQ_MOD, namingInt);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCounter(int number) {
-    return this->setValue("SEQ_NUM", number);
+    return this->setParameter(Parameters::SequenceCounter, number);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOutputPath(std::string path) {
     transform(path.begin(), path.end(), path.begin(), ::tolower);
-    return this->setValue("SEQ_PATH", path);
+    return this->setValue(RemoteParameter::SEQ_PATH, path);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOutputFileName(std::string name) {
-    return this->setValue("SEQ_ROOT", name);
+    return this->setValue(RemoteParameter::SEQ_ROOT, name);
 }
 
 std::string ThalesRemoteScriptWrapper::enableSequenceAcqGlobal(bool state) {
-    return this->setValue("SEQ_ACQENA", state == true ? -1 : 0);
+    return this->setValue(RemoteParameter::SEQ_ACQENA, state == true ? -1 : 0);
 }
 
 std::string ThalesRemoteScriptWrapper::disableSequenceAcqGlobal() {
@@ -875,8 +1073,11 @@ std::string ThalesRemoteScriptWrapper::disableSequenceAcqGlobal() {
 }
 
 std::string ThalesRemoteScriptWrapper::enableSequenceAcqChannel(int channel, bool state) {
-    std::string command = "SEQ_ACQ=" + std::to_string(channel) + ";" + std::to_string(state == true ? 1 : 0);
-    auto reply          = this->executeRemoteCommand(command);
+    Parameters::SequenceAcqChannel.check(channel);
+
+    auto reply = this->executeEncodedCommand(
+        this->commandEncoder.encodeParameter(RemoteParameter::SEQ_ACQ, channel, state)
+    );
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -904,43 +1105,43 @@ std::string ThalesRemoteScriptWrapper::runSequence() {
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceOhmicDrop(double value) {
-    return this->setValue("SEQ_RODROP", value);
+    return this->setParameter(Parameters::SequenceOhmicDrop, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceMaximumRuntime(double value) {
-    return this->setValue("SEQ_MAXTIME", value);
+    return this->setParameter(Parameters::SequenceMaximumRuntime, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceUpperPotentialLimit(double value) {
-    return this->setValue("SEQ_EUPPER", value);
+    return this->setParameter(Parameters::SequenceUpperPotentialLimit, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceLowerPotentialLimit(double value) {
-    return this->setValue("SEQ_ELOWER", value);
+    return this->setParameter(Parameters::SequenceLowerPotentialLimit, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceUpperCurrentLimit(double value) {
-    return this->setValue("SEQ_IUPPER", value);
+    return this->setParameter(Parameters::SequenceUpperCurrentLimit, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceLowerCurrentLimit(double value) {
-    return this->setValue("SEQ_ILOWER", value);
+    return this->setParameter(Parameters::SequenceLowerCurrentLimit, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCurrentRange(double value) {
-    return this->setValue("SEQ_IRANGE", value);
+    return this->setParameter(Parameters::SequenceCurrentRange, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequencePotentialLatencyWindow(double value) {
-    return this->setValue("SEQ_POTOFLO", value);
+    return this->setParameter(Parameters::SequencePotentialLatencyWindow, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setSequenceCurrentLatencyWindow(double value) {
-    return this->setValue("SEQ_CUROFLO", value);
+    return this->setParameter(Parameters::SequenceCurrentLatencyWindow, value);
 }
 
 std::string ThalesRemoteScriptWrapper::enableFraMode(bool enabled) {
-    return this->setValue("FRA", enabled);
+    return this->setValue(RemoteParameter::FRA, enabled);
 }
 
 std::string ThalesRemoteScriptWrapper::disableFraMode() {
@@ -948,51 +1149,51 @@ std::string ThalesRemoteScriptWrapper::disableFraMode() {
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageInputGain(double value) {
-    return this->setValue("FRA_POT_IN", value);
+    return this->setParameter(Parameters::FraVoltageInputGain, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageInputOffset(double value) {
-    return this->setValue("FRA_POT_IN_OFF", value);
+    return this->setParameter(Parameters::FraVoltageInputOffset, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageOutputGain(double value) {
-    return this->setValue("FRA_POT_OUT", value);
+    return this->setParameter(Parameters::FraVoltageOutputGain, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageOutputOffset(double value) {
-    return this->setValue("FRA_POT_OUT_OFF", value);
+    return this->setParameter(Parameters::FraVoltageOutputOffset, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageMinimum(double value) {
-    return this->setValue("FRA_POT_MIN", value);
+    return this->setParameter(Parameters::FraVoltageMinimum, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraVoltageMaximum(double value) {
-    return this->setValue("FRA_POT_MAX", value);
+    return this->setParameter(Parameters::FraVoltageMaximum, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentInputGain(double value) {
-    return this->setValue("FRA_CUR_IN", value);
+    return this->setParameter(Parameters::FraCurrentInputGain, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentInputOffset(double value) {
-    return this->setValue("FRA_CUR_IN_OFF", value);
+    return this->setParameter(Parameters::FraCurrentInputOffset, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentOutputGain(double value) {
-    return this->setValue("FRA_CUR_OUT", value);
+    return this->setParameter(Parameters::FraCurrentOutputGain, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentOutputOffset(double value) {
-    return this->setValue("FRA_CUR_OUT_OFF", value);
+    return this->setParameter(Parameters::FraCurrentOutputOffset, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentMinimum(double value) {
-    return this->setValue("FRA_CUR_MIN", value);
+    return this->setParameter(Parameters::FraCurrentMinimum, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraCurrentMaximum(double value) {
-    return this->setValue("FRA_CUR_MAX", value);
+    return this->setParameter(Parameters::FraCurrentMaximum, value);
 }
 
 std::string ThalesRemoteScriptWrapper::setFraPotentiostatMode(PotentiostatMode potentiostatMode) {
@@ -1031,18 +1232,18 @@ std::string ThalesRemoteScriptWrapper::readAllAcqChannels() {
     return reply;
 }
 
+AcqChannelValues ThalesRemoteScriptWrapper::readAcqChannels() {
+    return AcqChannelValues::fromReply(this->readAllAcqChannels());
+}
+
 double ThalesRemoteScriptWrapper::readAcqChannel(int channel) {
-    this->setValue("CHANNEL", channel);
+    this->setParameter(Parameters::AcqChannel, channel);
     return this->requestValueAndParseUsingRegexp("ANALOGIN", std::regex("=[\\s]*(.*)"));
 }
 
 
 std::string ThalesRemoteScriptWrapper::enableAcq(bool enabled) {
-    if (enabled == true) {
-        return this->executeRemoteCommand("ACQENA=1");
-    } else {
-        return this->executeRemoteCommand("ACQENA=0");
-    }
+    return this->executeEncodedCommand(this->commandEncoder.encodeParameter(RemoteParameter::ACQENA, enabled));
 }
 
 std::string ThalesRemoteScriptWrapper::disableAcq() {
@@ -1054,7 +1255,12 @@ std::string ThalesRemoteScriptWrapper::disableAcq() {
  */
 
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, PotentialRelation relation) {
+std::string ThalesRemoteScriptWrapper::executeEncodedCommand(std::string_view telegram) {
+    remoteConnection->sendTelegram(reinterpret_cast<const uint8_t*>(telegram.data()), telegram.size(), 2);
+    return remoteConnection->waitForStringTelegram(2);
+}
+
+std::string ThalesRemoteScriptWrapper::setValue(std::string_view name, PotentialRelation relation) {
     int relationInt;
 
     if (relation == PotentialRelation::RELATIVE_RELATED) {
@@ -1066,9 +1272,8 @@ std::string ThalesRemoteScriptWrapper::setValue(std::string name, PotentialRelat
     return this->setValue(name, relationInt);
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, bool value) {
-    int enable        = (value == true) ? 1 : 0;
-    std::string reply = this->executeRemoteCommand(name + "=" + std::to_string(enable));
+std::string ThalesRemoteScriptWrapper::setValue(std::string_view name, bool value) {
+    std::string reply = this->executeEncodedCommand(this->commandEncoder.encodeParameter(name, value));
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -1077,8 +1282,8 @@ std::string ThalesRemoteScriptWrapper::setValue(std::string name, bool value) {
     return reply;
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, double value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + to_string_with_precision(value, 10));
+std::string ThalesRemoteScriptWrapper::setValue(std::string_view name, double value) {
+    std::string reply = this->executeEncodedCommand(this->commandEncoder.encodeParameter(name, value));
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -1087,8 +1292,8 @@ std::string ThalesRemoteScriptWrapper::setValue(std::string name, double value)
     return reply;
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, int value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + std::to_string(value));
+std::string ThalesRemoteScriptWrapper::setValue(std::string_view name, int value) {
+    std::string reply = this->executeEncodedCommand(this->commandEncoder.encodeParameter(name, value));
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -1097,8 +1302,8 @@ std::string ThalesRemoteScriptWrapper::setValue(std::string name, int value) {
     return reply;
 }
 
-std::string ThalesRemoteScriptWrapper::setValue(std::string name, std::string value) {
-    std::string reply = this->executeRemoteCommand(name + "=" + value);
+std::string ThalesRemoteScriptWrapper::setValue(std::string_view name, std::string_view value) {
+    std::string reply = this->executeEncodedCommand(this->commandEncoder.encodeParameter(name, value));
 
     if (reply.find("ERROR") != std::string::npos) {
         throw ThalesRemoteError(reply);
@@ -31,6 +31,12 @@
 #include <regex>
 
 #include "thalesremoteconnection.h"
+#include "pad4impedance.h"
+#include "acqchannelvalues.h"
+#include "remotecommandencoder.h"
+#include "parameterdescriptor.h"
+#include "setupsnapshot.h"
+#include "adaptiveimpedance.h"
 
 enum class PotentiostatMode {
     POTENTIOSTATIC,     /**< Potentiostatic operation of the potentiostat, as a voltage source. */
@@ -91,6 +97,29 @@ public:
      */
     std::string executeRemoteCommand(std::string command);
 
+    /** Send a query to Remote Script without waiting for the response.
+     *
+     *  The response must be read later with readRemoteReply. Until then no other Remote Script
+     *  command may be executed with this wrapper, otherwise the responses are mixed up.
+     *
+     * \param  command The query string, e.g. "EIS" or "DOSEQ"
+     */
+    void sendRemoteCommand(std::string command);
+
+    /** Check if the response of a Remote Script query has arrived.
+     *
+     * \return true if a response can be read without blocking.
+     */
+    bool isRemoteReplyAvailable();
+
+    /** Read the response of a query sent with sendRemoteCommand.
+     *
+     *  Blocks until the response arrives.
+     *
+     * \return The response string from the device.
+     */
+    std::string readRemoteReply();
+
     /** Prompts Thales to start the Remote Script
      *
      * Will switch a running Thales from anywhere like the main menu after
@@ -154,6 +183,27 @@ public:
      */
     double getPotential();
 
+    /** Read the measured current with the timestamps of the request.
+     *
+     * \return The current value and the send and receive time of the request.
+     */
+    TimestampedValue<double> getCurrentTimestamped();
+
+    /** Read the measured voltage with the timestamps of the request.
+     *
+     * \return The voltage value and the send and receive time of the request.
+     */
+    TimestampedValue<double> getPotentialTimestamped();
+
+    /** Get the timestamps of the last Remote Script command.
+     *
+     *  The midpoint of send and receive time is the best estimate for the time at which the device executed
+     *  the command. Values read with other methods can be timestamped with this method directly after the call.
+     *
+     * \return The send and receive time in nanoseconds, see getMonotonicTimeInNanoseconds.
+     */
+    TelegramTimestamps getLastCommandTimestamps();
+
     /** Read the measured voltage from the device.
      *
      * \return The current voltage value.
@@ -302,6 +352,42 @@ public:
      */
     std::string readSetup();
 
+    /** Read the currently set parameters as snapshot.
+     *
+     *  Parses the reply of ThalesRemoteScriptWrapper::readSetup.
+     *
+     * \return The parsed setup.
+     */
+    SetupSnapshot readSetupSnapshot();
+
+    /** Restore a setup snapshot.
+     *
+     *  The snapshot is compared with the setup read by ThalesRemoteScriptWrapper::readSetupSnapshot and only
+     *  the differing parameters are set. If the snapshot contains parameters which SENDSETUP does not report,
+     *  the CV, IE, PAD4, FRA and sequence setups are read in this order until all of them are known.
+     *
+     * \param  target The setup to restore.
+     *
+     * \return The number of parameters which were set.
+     */
+    int restoreSetup(const SetupSnapshot& target);
+
+    /** Restore a setup snapshot.
+     *
+     *  Only the parameters which differ from the current state are set. All commands are sent at once and
+     *  the responses are read afterwards, so the time for the restore is about one round trip independent of
+     *  the number of parameters.
+     *
+     *  Read only and state changing parameters like DEV, Pot, EPC, MAXDEV and the limits Cmin, Cmax, Pmin and
+     *  Pmax are never set. An exception is thrown after all responses were read if one of the commands failed.
+     *
+     * \param  target The setup to restore.
+     * \param  current The current setup of the device, for example from a previous read or restore.
+     *
+     * \return The number of parameters which were set.
+     */
+    int restoreSetup(const SetupSnapshot& target, const SetupSnapshot& current);
+
     /** Perform offset calibration on the device.
      *
      * When the instrument has warmed up for about 30 minutes,
@@ -575,6 +661,27 @@ public:
      */
     std::complex<double> getImpedance(double frequency, double amplitude, int numberOfPeriods = 1);
 
+    /** Measure the impedance with a number of periods which adapts to the stability of the cell.
+     *
+     *  The point is measured with few periods first and measured again with twice the periods as long as two
+     *  successive estimates differ by more than the tolerance. The measurement also stops as soon as the
+     *  relative standard error of the mean reaches the target confidence, or when the maximum number of
+     *  measurements is reached.
+     *
+     *  On stable cells most points need only one or two short measurements, which saves a lot of time at
+     *  low frequencies compared to a fixed number of periods.
+     *
+     * \param  frequency The frequency to measure the impedance at.
+     * \param  amplitude The amplitude to measure the impedance with. In Volt if potentiostatic mode or Ampere for
+     * galvanostatic mode.
+     * \param  settings The settings for the adaption.
+     *
+     * \return The result with the impedance and the statistics of the adaption.
+     */
+    AdaptiveImpedanceResult getImpedanceAdaptive(double frequency,
+                                                 double amplitude,
+                                                 const AdaptiveImpedanceSettings& settings = AdaptiveImpedanceSettings());
+
     /** Measure the impedance with activated PAD4 channels at the set frequency, amplitude and averages.
      *
      * The function returns a string containing all impedance results. impedance is the MAIN channel all other padXX=
@@ -603,6 +710,33 @@ public:
      */
     std::string getImpedancePad4(double frequency, double amplitude, int numberOfPeriods = 1);
 
+    /** Measure the impedance with activated PAD4 channels at the set frequency, amplitude and averages.
+     *
+     *  Like ThalesRemoteScriptWrapper::getImpedancePad4 but the reply is parsed into a Pad4Impedance object.
+     *
+     * \return The impedance of the main channel and the 16 PAD4 channels.
+     */
+    Pad4Impedance measurePad4Impedance();
+
+    /** Measure the impedance with activated PAD4 channels at the set amplitude with set averages.
+     *
+     * \param  frequency the frequency to measure the impedance at.
+     *
+     * \return The impedance of the main channel and the 16 PAD4 channels.
+     */
+    Pad4Impedance measurePad4Impedance(double frequency);
+
+    /** Measure the impedace with activated PAD4 channels with all possible parameters
+     *
+     * \param  frequency The frequency to measure the impedance at.
+     * \param  amplitude The amplitude to measure the impedance with. In Volt if potentiostatic mode or Ampere for
+     * galvanostatic mode.
+     * \param  numberOfPeriods The number of periods / waves to average.
+     *
+     * \return The impedance of the main channel and the 16 PAD4 channels.
+     */
+    Pad4Impedance measurePad4Impedance(double frequency, double amplitude, int numberOfPeriods = 1);
+
     /** Set the measurement naming rule.
      *
      * \param  naming The measurement naming rule.
@@ -1509,6 +1643,15 @@ public:
      */
     std::string readAllAcqChannels();
 
+    /** Read all active ACQ channels and parse the values.
+     *
+     *  All channels are read with one round trip and parsed in a single pass.
+     *  This is considerably faster than calling ThalesRemoteScriptWrapper::readAcqChannel for each channel.
+     *
+     * \return The values of the active ACQ channels.
+     */
+    AcqChannelValues readAcqChannels();
+
     /** Read the ACQ channel to the passed index.
      *
      * @param channel Display channel index.
@@ -1534,6 +1677,29 @@ public:
     std::string disableAcq();
 
 protected:
+    /** Send an already encoded Remote Script telegram and wait for the response.
+     *
+     * \param  telegram The encoded command from the RemoteCommandEncoder.
+     *
+     * \return The response string from the device.
+     */
+    std::string executeEncodedCommand(std::string_view telegram);
+
+    /** Set a Remote2 parameter after checking the value against its descriptor.
+     *
+     *  Invalid values are rejected with a ParameterRangeError before anything is sent to Thales.
+     *
+     * \param  descriptor The descriptor of the Remote2 parameter.
+     * \param  value The value of the parameter.
+     *
+     * \return The response string from the device.
+     */
+    template <typename T>
+    std::string setParameter(const ParameterDescriptor<T>& descriptor, T value) {
+        descriptor.check(value);
+        return this->setValue(descriptor.key, value);
+    }
+
     /** Set an Remote2 parameter or value.
      *
      *  With this command the parameters are transmitted to the Thales Remote2 and the response is read.
@@ -1543,7 +1709,7 @@ protected:
      *
      * \return The response string from the device.
      */
-    std::string setValue(std::string name, PotentialRelation relation);
+    std::string setValue(std::string_view name, PotentialRelation relation);
 
     /** Set an Remote2 parameter or value.
      *
@@ -1554,7 +1720,7 @@ protected:
      *
      * \return The response string from the device.
      */
-    std::string setValue(std::string name, bool value);
+    std::string setValue(std::string_view name, bool value);
 
     /** Set an Remote2 parameter or value.
      *
@@ -1565,7 +1731,7 @@ protected:
      *
      * \return The response string from the device.
      */
-    std::string setValue(std::string name, double value);
+    std::string setValue(std::string_view name, double value);
 
     /** Set an Remote2 parameter or value.
      *
@@ -1576,7 +1742,7 @@ protected:
      *
      * \return The response string from the device.
      */
-    std::string setValue(std::string name, int value);
+    std::string setValue(std::string_view name, int value);
 
     /** Set an Remote2 parameter or value.
      *
@@ -1587,7 +1753,7 @@ protected:
      *
      * \return The response string from the device.
      */
-    std::string setValue(std::string name, std::string value);
+    std::string setValue(std::string_view name, std::string_view value);
 
     /** Sending a Remote2 command and parsing a double from the response.
      *
@@ -1618,6 +1784,9 @@ protected:
     int stringToInt(std::string string);
 
     ZenniumConnection* const remoteConnection;
+
+    /** Buffer in which the commands are formatted before sending. */
+    RemoteCommandEncoder commandEncoder;
 };
 
 #endif  // THALESREMOTESCRIPTWRAPPER_H
@@ -26,9 +26,10 @@
 #include "threadsafequeue.h"
 #include <chrono>
 
-ThreadsafeQueue::ThreadsafeQueue()
+ThreadsafeQueue::ThreadsafeQueue() :
+    interrupted(false)
 {
-    dataAvailable.lock();
+
 }
 
 ThreadsafeQueue::~ThreadsafeQueue() { }
@@ -45,49 +46,62 @@ unsigned long ThreadsafeQueue::size() const
     return queue.size();
 }
 
-std::vector<uint8_t> ThreadsafeQueue::pop()
+std::vector<uint8_t> ThreadsafeQueue::pop(int64_t *receiveTime)
 {
     std::lock_guard<std::mutex> lock(mutex);
     if (queue.empty()) {
         return {};
     }
-    std::vector<uint8_t> tmp = queue.front();
+    std::vector<uint8_t> tmp = std::move(queue.front().data);
+    if (receiveTime != nullptr) {
+        *receiveTime = queue.front().receiveTime;
+    }
     queue.pop();
     return tmp;
 }
 
-void ThreadsafeQueue::put(const std::vector<uint8_t> &item)
+void ThreadsafeQueue::put(const std::vector<uint8_t> &item, int64_t receiveTime)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    queue.push(item);
-    dataAvailable.unlock();
+    this->put(std::vector<uint8_t>(item), receiveTime);
 }
 
-std::vector<uint8_t> ThreadsafeQueue::get(const bool blocking, const std::chrono::duration<int, std::milli> timeout)
+void ThreadsafeQueue::put(std::vector<uint8_t> &&item, int64_t receiveTime)
 {
-    std::vector<uint8_t> retval = {};
-    if(blocking == false)
     {
-        retval = this->pop();
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(Entry{std::move(item), receiveTime});
     }
-    else
+    dataAvailable.notify_one();
+}
+
+std::vector<uint8_t> ThreadsafeQueue::get(const bool blocking, const std::chrono::duration<int, std::milli> timeout, int64_t *receiveTime)
+{
+    if(blocking == false)
     {
-        std::chrono::milliseconds startTime = std::chrono::duration_cast<std::chrono::milliseconds >(std::chrono::system_clock::now().time_since_epoch());
-        std::chrono::duration<int, std::milli> remainingTime;
-        std::chrono::duration<int, std::milli> elapsedTime;
+        return this->pop(receiveTime);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    dataAvailable.wait_for(lock, timeout, [this]() {
+        return queue.empty() == false || interrupted == true;
+    });
 
-        while (this->empty() == true)
-        {
-            elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds >(std::chrono::system_clock::now().time_since_epoch()) - startTime;
-            if (elapsedTime > timeout)
-            {
-                break;
-            }
-            remainingTime = timeout - elapsedTime;
+    if (queue.empty()) {
+        return {};
+    }
+    std::vector<uint8_t> tmp = std::move(queue.front().data);
+    if (receiveTime != nullptr) {
+        *receiveTime = queue.front().receiveTime;
+    }
+    queue.pop();
+    return tmp;
+}
 
-            dataAvailable.try_lock_for(remainingTime);
-        }
-        retval = this->pop();
+void ThreadsafeQueue::setInterrupted(bool interrupt)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        interrupted = interrupt;
     }
-    return retval;
-};
+    dataAvailable.notify_all();
+}
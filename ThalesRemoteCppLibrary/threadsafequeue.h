@@ -28,17 +28,28 @@
 
 #include <queue>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <cstring>
+#include <cstdint>
+#include <chrono>
 
 /** Class which implements a thread-safe FIFO queue.
  *
  */
 class ThreadsafeQueue
 {
-    std::queue< std::vector<uint8_t> > queue;
+    class Entry
+    {
+    public:
+        std::vector<uint8_t> data;
+        int64_t receiveTime;
+    };
+
+    std::queue<Entry> queue;
     mutable std::mutex mutex;
-    std::timed_mutex dataAvailable;
+    std::condition_variable dataAvailable;
+    bool interrupted;
 
 public:
     ThreadsafeQueue();
@@ -64,16 +75,25 @@ public:
     /** Adding an element to the queue.
      *
      * @param item The element to add.
+     * @param receiveTime Time when the element was received in nanoseconds, see getMonotonicTimeInNanoseconds.
+     */
+    void put(const std::vector<uint8_t> &item, int64_t receiveTime = 0);
+
+    /** Adding an element to the queue without copying it.
+     *
+     * @param item The element to add.
+     * @param receiveTime Time when the element was received in nanoseconds, see getMonotonicTimeInNanoseconds.
      */
-    void put(const std::vector<uint8_t> &item);
+    void put(std::vector<uint8_t> &&item, int64_t receiveTime = 0);
 
     /** Non-blocking read from the queue.
      *
      * If the queue is empty, a vector with length 0 is returned.
      *
+     * @param receiveTime If not nullptr, receives the time passed to put.
      * @return An element of the queue.
      */
-    std::vector<uint8_t> pop();
+    std::vector<uint8_t> pop(int64_t *receiveTime = nullptr);
 
     /** Blocking and non-blocking read from the queue.
      *
@@ -83,9 +103,19 @@ public:
      *
      * @param blocking true to wait for timeout time.
      * @param timeout Time to wairt for data.
+     * @param receiveTime If not nullptr, receives the time passed to put.
      * @return An element of the queue.
      */
-    std::vector<uint8_t> get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max());
+    std::vector<uint8_t> get(const bool blocking = true, const std::chrono::duration<int, std::milli> timeout = std::chrono::duration<int, std::milli>::max(), int64_t *receiveTime = nullptr);
+
+    /** Interrupt blocking reads.
+     *
+     * While the queue is interrupted, a blocking read returns immediately with the next element or with
+     * a vector with length 0 if the queue is empty. Threads which are already waiting are woken up.
+     *
+     * @param interrupt true to interrupt, false to allow blocking reads again.
+     */
+    void setInterrupted(bool interrupt);
 };
 
 #endif // THREADSAFEQUEUE_H
@@ -0,0 +1,85 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TIMESTAMPEDVALUE_H
+#define TIMESTAMPEDVALUE_H
+
+#include <chrono>
+#include <cstdint>
+
+/** Get the time of the monotonic clock used for all telegram timestamps.
+ *
+ *  The clock is std::chrono::steady_clock, it is not affected by changes of the system time.
+ *
+ * \return The time in nanoseconds.
+ */
+inline int64_t getMonotonicTimeInNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Send and receive time of a request to Term.
+ *
+ *  The times are in nanoseconds of the clock of getMonotonicTimeInNanoseconds. A time of 0 means that
+ *  no telegram was sent or received yet.
+ */
+class TelegramTimestamps
+{
+public:
+    int64_t sendTime = 0;       /**< Time when the request was written to the socket. */
+    int64_t receiveTime = 0;    /**< Time when the reply was read from the socket. */
+
+    /** Get the round trip time.
+     *
+     * \return The time between send and receive in nanoseconds.
+     */
+    int64_t getRoundTripTime() const
+    {
+        return this->receiveTime - this->sendTime;
+    }
+
+    /** Get the midpoint between send and receive.
+     *
+     *  This is the best estimate for the time at which the device sampled the value.
+     *
+     * \return The midpoint in nanoseconds.
+     */
+    int64_t getMidpoint() const
+    {
+        return this->sendTime + (this->receiveTime - this->sendTime) / 2;
+    }
+};
+
+/** A value read from the device together with the timestamps of the request. */
+template <typename T>
+class TimestampedValue
+{
+public:
+    T value{};                      /**< The value. */
+    TelegramTimestamps timestamps;  /**< Send and receive time of the request. */
+};
+
+#endif // TIMESTAMPEDVALUE_H
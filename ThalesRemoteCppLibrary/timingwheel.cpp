@@ -0,0 +1,133 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "timingwheel.h"
+
+TimingWheel::TimingWheel() :
+    currentTick(0),
+    numberOfTimers(0)
+{
+
+}
+
+void TimingWheel::schedule(uint64_t id, uint64_t expiryTick)
+{
+    this->insert(Timer{id, expiryTick});
+    this->numberOfTimers++;
+}
+
+void TimingWheel::advance(uint64_t tick, std::vector<uint64_t>& expired)
+{
+    this->collectDue(expired);
+
+    while (this->currentTick < tick)
+    {
+        this->currentTick++;
+
+        /*
+         * When a level wraps around, the next slot of the level above is moved down.
+         * The highest level has to be cascaded first, so its timers can reach level 0.
+         */
+        for (int level = numberOfLevels - 1; level > 0; level--)
+        {
+            const uint64_t lowerBitsMask = (uint64_t(1) << (bitsPerLevel * level)) - 1;
+            if ((this->currentTick & lowerBitsMask) == 0)
+            {
+                this->cascade(level);
+            }
+        }
+
+        auto& slot = this->slots[0][this->currentTick & (slotsPerLevel - 1)];
+        for (const auto& timer : slot)
+        {
+            expired.push_back(timer.id);
+        }
+        this->numberOfTimers -= slot.size();
+        slot.clear();
+
+        this->collectDue(expired);
+    }
+}
+
+uint64_t TimingWheel::getCurrentTick() const
+{
+    return this->currentTick;
+}
+
+size_t TimingWheel::size() const
+{
+    return this->numberOfTimers;
+}
+
+void TimingWheel::insert(const Timer& timer)
+{
+    if (timer.expiryTick <= this->currentTick)
+    {
+        this->due.push_back(timer);
+        return;
+    }
+
+    const uint64_t delta = timer.expiryTick - this->currentTick;
+    for (int level = 0; level < numberOfLevels; level++)
+    {
+        if (delta < (uint64_t(1) << (bitsPerLevel * (level + 1))))
+        {
+            const auto slot = (timer.expiryTick >> (bitsPerLevel * level)) & (slotsPerLevel - 1);
+            this->slots[level][slot].push_back(timer);
+            return;
+        }
+    }
+
+    /*
+     * Beyond the range of the wheel: park the timer in the slot of the last level which is reached
+     * last and insert it again when this slot is cascaded.
+     */
+    const int level = numberOfLevels - 1;
+    const auto slot = ((this->currentTick >> (bitsPerLevel * level)) - 1) & (slotsPerLevel - 1);
+    this->slots[level][slot].push_back(timer);
+}
+
+void TimingWheel::collectDue(std::vector<uint64_t>& expired)
+{
+    for (const auto& timer : this->due)
+    {
+        expired.push_back(timer.id);
+    }
+    this->numberOfTimers -= this->due.size();
+    this->due.clear();
+}
+
+void TimingWheel::cascade(int level)
+{
+    auto& slot = this->slots[level][(this->currentTick >> (bitsPerLevel * level)) & (slotsPerLevel - 1)];
+    std::vector<Timer> timers;
+    timers.swap(slot);
+
+    for (const auto& timer : timers)
+    {
+        this->insert(timer);
+    }
+}
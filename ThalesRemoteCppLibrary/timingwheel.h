@@ -0,0 +1,108 @@
+/******************************************************************
+ *  ____       __                        __    __   __      _ __
+ * /_  / ___ _/ /  ___  ___ ___________ / /__ / /__/ /_____(_) /__
+ *  / /_/ _ `/ _ \/ _ \/ -_) __/___/ -_) / -_)  '_/ __/ __/ /  '_/
+ * /___/\_,_/_//_/_//_/\__/_/      \__/_/\__/_/\_\\__/_/ /_/_/\_\
+ *
+ * Copyright 2024 ZAHNER-elektrik I. Zahner-Schiller GmbH & Co. KG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** The TimingWheel class
+ *
+ *  Hierarchical timing wheel for timers with a fixed tick resolution.
+ *
+ *  The wheel has three levels with 256 slots each. Level 0 holds the timers which expire within the next
+ *  256 ticks, level 1 those within 256^2 ticks and level 2 those within 256^3 ticks. When the lower levels
+ *  wrap around, the timers of the next slot of the higher level are moved down. Adding a timer and
+ *  advancing by one tick therefore cost constant time, independent of the number of timers.
+ *
+ *  Timers further in the future than the range of the wheel are kept in the last level and moved down
+ *  when their slot is reached. Timers are identified by an id chosen by the caller. The class is not
+ *  thread-safe.
+ */
+class TimingWheel
+{
+public:
+    static constexpr int numberOfLevels = 3;
+    static constexpr int bitsPerLevel = 8;
+    static constexpr int slotsPerLevel = 1 << bitsPerLevel;
+
+    TimingWheel();
+
+    /** Add a timer.
+     *
+     *  Timers which are already due are returned by the next call of advance.
+     *
+     * \param  id The id of the timer.
+     * \param  expiryTick The tick at which the timer expires.
+     */
+    void schedule(uint64_t id, uint64_t expiryTick);
+
+    /** Advance the wheel and collect the expired timers.
+     *
+     * \param  tick The new current tick.
+     * \param  expired The ids of the expired timers are appended to this vector.
+     */
+    void advance(uint64_t tick, std::vector<uint64_t>& expired);
+
+    /** Get the current tick.
+     *
+     * \return The tick.
+     */
+    uint64_t getCurrentTick() const;
+
+    /** Get the number of timers in the wheel.
+     *
+     * \return The number of timers.
+     */
+    size_t size() const;
+
+private:
+    class Timer
+    {
+    public:
+        uint64_t id;
+        uint64_t expiryTick;
+    };
+
+    /** Insert a timer into the slot matching its expiry tick. */
+    void insert(const Timer& timer);
+
+    /** Move the timers of the current slot of a level to the lower levels. */
+    void cascade(int level);
+
+    /** Move the timers which are already due to the expired list. */
+    void collectDue(std::vector<uint64_t>& expired);
+
+    std::array<std::array<std::vector<Timer>, slotsPerLevel>, numberOfLevels> slots;
+    std::vector<Timer> due;
+    uint64_t currentTick;
+    size_t numberOfTimers;
+};
+
+#endif // TIMINGWHEEL_H